@@ -47,6 +47,7 @@
 #include "partition_iterator.h"
 #include "partition_range.h"
 #include "size_linear.h"
+#include "radix_sort.h"
 
 
 #include <boost/preprocessor/repetition/enum.hpp>
@@ -199,6 +200,12 @@ namespace tc {
 				_ASSERTE( tc::is_sorted(rng, less) );
 			} else {
 #endif
+				if constexpr( radix_sort_detail::sortable_by_less<Rng, Less> ) {
+					if( !std::is_constant_evaluated() && radix_sort_detail::c_nMinRadixSortSize <= tc::size_raw(rng) ) {
+						tc::radix_sort_inplace(rng, radix_sort_detail::key_projection(less));
+						return;
+					}
+				}
 				std::sort( tc::begin(rng), tc::end(rng), std::forward<Less>(less) );
 #ifdef __clang__
 			}
@@ -208,6 +215,12 @@ namespace tc {
 
 	template<typename Rng, typename Less = tc::fn_less>
 	void stable_sort_inplace(Rng&& rng, Less&& less = Less()) noexcept {
+		if constexpr( radix_sort_detail::sortable_by_less<Rng, Less> ) {
+			if( radix_sort_detail::c_nMinRadixSortSize <= tc::size_raw(rng) ) {
+				tc::radix_sort_inplace(rng, radix_sort_detail::key_projection(less)); // radix sort is stable
+				return;
+			}
+		}
 		std::stable_sort(tc::begin(rng), tc::end(rng), std::forward<Less>(less));
 	}
 
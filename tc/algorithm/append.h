@@ -22,6 +22,8 @@
 #include "../range/transform.h"
 #include "../range/concat_adaptor.h"
 
+#include <boost/container/container_fwd.hpp>
+
 namespace tc {
 	namespace append_detail {
 		template<typename Rng, typename TTarget>
@@ -46,6 +48,36 @@ namespace tc {
 			tc::econstructionIMPLICIT==tc::construction_restrictiveness<tc::range_value_t<Cont>, std::iter_reference_t<tc::iterator_t<Rng>>>::value;
 	}
 
+	namespace append_detail {
+		// Reserving a loose upper bound, e.g., of a filter, speculatively may allocate memory that is never used.
+		// Its unused part is given back afterwards, but for far-off bounds, e.g., a filtered tc::iota, the speculation is limited.
+		inline constexpr std::size_t c_nMaxSpeculativeReserveBytes = 1 << 24;
+
+		template<typename Cont, typename Rng, typename Sink>
+		constexpr auto reserving_for_each(Cont& cont, Rng&& rng, Sink const& sink) MAYTHROW -> decltype(tc::implicit_cast<void>(tc::for_each(std::forward<Rng>(rng), sink))) {
+			auto const bounds = tc::size_hint(rng); // MAYTHROW
+			auto const nSizeBefore = cont.size();
+			if( bounds.exact() || (!tc::has_mem_fn_size_hint<std::remove_cvref_t<Rng>> && bounds.m_onUpper) ) {
+				// The bound is the size, or a tc::size_upper_bound that is tight by design, e.g., the c_nMaxSize of a number.
+				tc::cont_reserve(cont, nSizeBefore + *bounds.m_onUpper);
+				tc::for_each(std::forward<Rng>(rng), sink); // MAYTHROW
+			} else {
+				auto const nCapacityBefore = cont.capacity();
+				auto nReserve = bounds.m_nLower;
+				if( bounds.m_onUpper ) {
+					nReserve += tc::min(*bounds.m_onUpper - bounds.m_nLower, c_nMaxSpeculativeReserveBytes / sizeof(tc::range_value_t<Cont>));
+				}
+				tc::cont_reserve(cont, nSizeBefore + nReserve);
+				tc::for_each(std::forward<Rng>(rng), sink); // MAYTHROW
+				if constexpr( requires { cont.shrink_to_fit(); } ) {
+					if( nCapacityBefore <= cont.size() && cont.size() < cont.capacity() / 2 ) {
+						NOBADALLOC(cont.shrink_to_fit());
+					}
+				}
+			}
+		}
+	}
+
 	namespace append_no_adl {
 		template< typename Cont, bool bReserve = has_mem_fn_reserve<Cont>>
 		struct [[nodiscard]] appender_type;
@@ -88,13 +120,43 @@ namespace tc {
 			// https://stackoverflow.com/questions/51933397/sfinae-method-completely-disables-base-classs-template-method-in-clang
 			template< typename Rng, ENABLE_SFINAE, std::enable_if_t<
 				!append_detail::conv_enc_needed<Rng, tc::range_value_t<Cont>> &&
-				tc::has_size<Rng> &&
+				tc::has_size_hint<Rng> &&
 				!append_detail::range_insertable<Rng, Cont>
 			>* = nullptr>
 			constexpr auto chunk(Rng&& rng, int = 0) const& return_decltype_MAYTHROW(
-				tc::cont_reserve(this->m_cont, this->m_cont.size()+tc::size(rng)),
-				tc::implicit_cast<void>(tc::for_each(std::forward<Rng>(rng), tc::base_cast</*SFINAE_TYPE to workaround clang bug*/SFINAE_TYPE(base_)>(*this)))
+				append_detail::reserving_for_each(this->m_cont, std::forward<Rng>(rng), tc::base_cast</*SFINAE_TYPE to workaround clang bug*/SFINAE_TYPE(base_)>(*this))
 			)
+
+			// UTF-8 <-> UTF-16 of contiguous memory is transcoded directly into the storage of the container. Storage for the worst
+			// case is not zero-filled first where the container allows it: std::basic_string::resize_and_overwrite, available
+			// since C++23, or resize with boost::container::default_init. Otherwise, zero-filling costs less than transcoding.
+			template<append_detail::conv_enc_needed<tc::range_value_t<Cont>> Rng> requires
+				convert_enc_detail::bulk_transcodable<Rng, tc::range_value_t<Cont>> &&
+				tc::contiguous_range<Cont> &&
+				requires(Cont& cont) { tc::cont_extend(cont, cont.size()); }
+			void chunk(Rng&& rng) const& noexcept {
+				using Src = tc::range_value_t<Rng>;
+				Src const* pSrc = std::to_address(tc::begin(rng));
+				Src const* const pEnd = std::to_address(tc::end(rng));
+				auto const nOffset = this->m_cont.size();
+				auto const nMaxSize = nOffset + tc::transcode_utf_detail::max_dst_size<tc::range_value_t<Cont>>(tc::explicit_cast<std::size_t>(pEnd - pSrc));
+#ifdef __cpp_lib_string_resize_and_overwrite
+				if constexpr( requires(Cont& cont) { cont.resize_and_overwrite(nMaxSize, [](tc::range_value_t<Cont>*, std::size_t const n) noexcept { return n; }); } ) {
+					tc::cont_reserve(this->m_cont, nMaxSize); // grows geometrically, unlike resize_and_overwrite
+					NOBADALLOC(this->m_cont.resize_and_overwrite(nMaxSize, [&](tc::range_value_t<Cont>* const pBegin, std::size_t) noexcept {
+						return tc::explicit_cast<std::size_t>(convert_enc_detail::transcode(pSrc, pEnd, pEnd, pBegin + nOffset) - pBegin);
+					}));
+					return;
+				}
+#endif
+				if constexpr( requires(Cont& cont) { tc::cont_extend(cont, nMaxSize, boost::container::default_init); } ) {
+					tc::cont_extend(this->m_cont, nMaxSize, boost::container::default_init);
+				} else {
+					tc::cont_extend(this->m_cont, nMaxSize);
+				}
+				auto const pDst = convert_enc_detail::transcode(pSrc, pEnd, pEnd, tc::ptr_begin(this->m_cont) + nOffset);
+				tc::take_first_inplace(this->m_cont, tc::explicit_cast<typename Cont::size_type>(pDst - tc::ptr_begin(this->m_cont)));
+			}
 		};
 	}
 	using append_no_adl::appender_type;
@@ -126,6 +188,11 @@ namespace tc {
 			static_assert( std::is_same<RangeReturn, tc::return_void>::value, "RangeReturn not supported, if appending to stream." );
 
 			tc::for_each(std::forward<Rng>(rng), tc::appender(cont));
+		} else if constexpr( has_mem_fn_hash_function<Cont> ) {
+			// elements are not appended at the end, so there is neither a range of appended elements nor a cheap rollback
+			static_assert( std::is_same<RangeReturn, tc::return_void>::value, "RangeReturn not supported, if appending to hash container." );
+
+			tc::for_each(std::forward<Rng>(rng), tc::appender(cont)); // MAYTHROW
 		} else if constexpr( tc::random_access_range<Cont> || has_mem_fn_reserve<Cont> ) {
 			auto const nOffset = tc::size_raw(cont);
 			try {
@@ -13,6 +13,10 @@
 #include "../string/format.h"
 #include "../static_vector.h"
 #include "../range/filter_adaptor.h"
+#include "../range/join_adaptor.h"
+#include "../range/take_while.h"
+#include "../range/iota_range.h"
+#include "quantifier.h"
 
 
 static_assert(tc::appendable<char const*, tc::string<char>&>);
@@ -107,3 +111,115 @@ UNITTESTDEF(SReportStreamExceptionTest) {
 	);
 }
 #endif
+
+namespace {
+	struct chunk_counting_sink final {
+		tc::vector<int>& m_vecn;
+		int& m_nChunks;
+
+		void operator()(int const n) const& noexcept {
+			tc::cont_emplace_back(m_vecn, n);
+		}
+
+		template<typename Rng>
+		void chunk(Rng&& rng) const& noexcept {
+			++m_nChunks;
+			tc::append(m_vecn, rng);
+		}
+	};
+
+	struct breaking_sink final {
+		tc::vector<int>& m_vecn;
+
+		tc::break_or_continue operator()(int const n) const& noexcept {
+			tc::cont_emplace_back(m_vecn, n);
+			return tc::continue_if(tc::size(m_vecn) < 3);
+		}
+
+		template<tc::contiguous_range Rng>
+		tc::break_or_continue chunk(Rng&& rng) const& noexcept {
+			tc::append(m_vecn, rng);
+			return tc::continue_if(tc::size(m_vecn) < 3);
+		}
+	};
+}
+
+UNITTESTDEF(append_chunk_through_adaptors) {
+	tc::vector<int> vecnSrc;
+	for( int i = 0; i < 1000; ++i ) tc::cont_emplace_back(vecnSrc, i);
+
+	{
+		// transform passes chunks on as transformed views
+		tc::vector<int> vecn;
+		int nChunks = 0;
+		tc::for_each(tc::transform(tc::make_generator_range(vecnSrc), [](int const n) noexcept { return n + 1; }), chunk_counting_sink{vecn, nChunks});
+		_ASSERTEQUAL(nChunks, 1);
+		_ASSERT(tc::equal(vecn, tc::transform(vecnSrc, [](int const n) noexcept { return n + 1; })));
+	}
+	{
+		// filter stages kept elements in blocks
+		tc::vector<int> vecn;
+		int nChunks = 0;
+		tc::for_each(tc::filter(vecnSrc, [](int const n) noexcept { return 0 == n % 2; }), chunk_counting_sink{vecn, nChunks});
+		_ASSERT(0 < nChunks && nChunks < 10);
+		_ASSERTEQUAL(tc::size(vecn), 500);
+		_ASSERT(tc::all_of(vecn, [](int const n) noexcept { return 0 == n % 2; }));
+	}
+	{
+		// but not to sinks that may break, which must not see the predicate evaluated beyond the element they break at
+		tc::vector<int> vecn;
+		int nPredCalls = 0;
+		_ASSERTEQUAL(tc::for_each(tc::filter(vecnSrc, [&](int const n) noexcept { ++nPredCalls; return 0 == n % 2; }), breaking_sink{vecn}), tc::break_);
+		_ASSERTEQUAL(tc::size(vecn), 3);
+		_ASSERTEQUAL(nPredCalls, 5);
+	}
+	{
+		tc::vector<int> vecn;
+		tc::append(vecn, tc::filter(tc::transform(vecnSrc, [](int const n) noexcept { return n * 3; }), [](int const n) noexcept { return 0 == n % 2; }));
+		_ASSERTEQUAL(tc::size(vecn), 500);
+		_ASSERTEQUAL(tc::back(vecn), 2994);
+	}
+}
+
+UNITTESTDEF(size_hint) {
+	tc::vector<int> const vecn{1, 2, 3, 4, 5, 6, 7, 8, 9, 10};
+	auto const Odd = [](int const n) noexcept { return 1 == n % 2; };
+	auto const AssertBounds = [](tc::size_bounds const& bounds, std::size_t const nLower, std::optional<std::size_t> const onUpper) noexcept {
+		_ASSERTEQUAL(bounds.m_nLower, nLower);
+		_ASSERTEQUAL(bounds.m_onUpper, onUpper);
+	};
+	AssertBounds(tc::size_hint(vecn), 10, 10);
+	AssertBounds(tc::size_hint(tc::filter(vecn, Odd)), 0, 10);
+	AssertBounds(tc::size_hint(tc::take_while(vecn, [](int const n) noexcept { return n < 4; })), 0, 10);
+	AssertBounds(tc::size_hint(tc::concat(vecn, tc::filter(vecn, Odd))), 10, 20);
+	AssertBounds(tc::size_hint(tc::concat(vecn, [](auto sink) noexcept { sink(1); })), 10, std::nullopt);
+	AssertBounds(tc::size_hint(tc::as_dec(5)), 0, tc::as_dec(5).c_nMaxSize);
+
+	tc::vector<tc::vector<int>> const vecvecn{{1, 2}, {}, {3, 4, 5}};
+	_ASSERT(tc::size_hint(tc::join(vecvecn)).exact());
+	AssertBounds(tc::size_hint(tc::join(vecvecn)), 5, 5);
+	AssertBounds(tc::size_hint(tc::join(tc::transform(vecvecn, [&](auto const& vecnInner) noexcept { return tc::filter(vecnInner, Odd); }))), 0, std::nullopt); // would create the inner ranges twice
+
+	// generator ranges are appended after a single allocation
+	auto const vecnRange = tc::make_vector(tc::iota(0, 1000));
+	auto const vecnMost = tc::make_vector(tc::filter(vecnRange, [](int const n) noexcept { return n < 900; }));
+	_ASSERTEQUAL(tc::size(vecnMost), 900);
+	_ASSERTEQUAL(vecnMost.capacity(), 1000);
+	auto const vecnJoined = tc::make_vector(tc::join(vecvecn), tc::filter(vecn, Odd));
+	TEST_RANGE_EQUAL(vecnJoined, (tc::vector<int>{1, 2, 3, 4, 5, 1, 3, 5, 7, 9}));
+	_ASSERTEQUAL(vecnJoined.capacity(), 15);
+
+	// and give back memory if the upper bound was far off
+	auto const vecnFew = tc::make_vector(tc::filter(vecnRange, [](int const n) noexcept { return n < 10; }));
+	_ASSERTEQUAL(tc::size(vecnFew), 10);
+	_ASSERT(vecnFew.capacity() < 1000);
+
+	// a tc::size_upper_bound is reserved completely and kept
+	tc::vector<char> vech;
+	tc::append(vech, tc::as_dec(5));
+	_ASSERTEQUAL(vech.capacity(), tc::as_dec(5).c_nMaxSize);
+
+	// filtering tc::iota does not reserve its whole size
+	auto const vecnIota = tc::make_vector(tc::take_while(tc::filter(tc::iota(0, std::numeric_limits<int>::max()), Odd), [](int const n) noexcept { return n < 10; }));
+	TEST_RANGE_EQUAL(vecnIota, (tc::vector<int>{1, 3, 5, 7, 9}));
+}
@@ -239,6 +239,23 @@ namespace tc {
 		constexpr auto lexicographical_compare_3way_impl( Lhs const& lhs, Rhs const& rhs, FnCompare fnCompare) noexcept ->
 			decltype(fnCompare(*tc::begin(lhs), *tc::begin(rhs)))
 		{
+			if constexpr( tc::simd_detail::contiguous_bitwise_comparable<Lhs const&, Rhs const&> && std::is_same<tc::decay_t<FnCompare>, tc::fn_compare>::value ) {
+				if( !std::is_constant_evaluated() ) {
+					// Find the first mismatch with vectorized comparison, then only compare the mismatching elements.
+					auto const pLhs = std::to_address(tc::begin(lhs));
+					auto const nLhs = tc::explicit_cast<std::size_t>(std::to_address(tc::end(lhs)) - pLhs);
+					auto const pRhs = std::to_address(tc::begin(rhs));
+					auto const nRhs = tc::explicit_cast<std::size_t>(std::to_address(tc::end(rhs)) - pRhs);
+					auto const i = tc::simd_detail::mismatch(pLhs, pRhs, tc::min(nLhs, nRhs));
+					if( i < nLhs && i < nRhs ) return fnCompare(pLhs[i], pRhs[i]);
+					if constexpr(eprefixEQUIVALENT==eprefix) {
+						if( i == nLhs ) return std::strong_ordering::equivalent;
+					} else if constexpr(eprefixFORBID==eprefix) {
+						_ASSERTE(nLhs == nRhs);
+					}
+					return tc::compare(nLhs, nRhs);
+				}
+			}
 			auto itLhs=tc::begin( lhs );
 			auto const itLhsEnd=tc::end( lhs );
 			auto itRhs=tc::begin( rhs );
@@ -14,11 +14,14 @@
 #include "../base/modified.h"
 
 #include "for_each.h"
+#include "simd.h"
 #include "../base/assign.h"
 
 #include <boost/range/iterator.hpp>
 
+#include <cstring>
 #include <functional>
+#include <memory>
 #include <unordered_set>
 #include <unordered_map>
 
@@ -92,6 +95,10 @@ namespace tc{
 			template<typename... X> struct is_unordered_range<std::unordered_map<X...>> : tc::constant<true> {};
 		}
 
+		// Predicates which compare scalars with operator==, so contiguous ranges of scalars can be compared bytewise.
+		template<typename Pred>
+		concept equality_pred = std::is_same<tc::decay_t<Pred>, tc::fn_equal_to_or_parse_match>::value || std::is_same<tc::decay_t<Pred>, tc::fn_equal_to>::value;
+
 		template<typename It, typename ItEnd, typename RRng, typename Pred>
 		[[nodiscard]] constexpr bool starts_with(It& it, ItEnd itEnd, RRng&& rrng, Pred pred) noexcept(noexcept(tc::continue_ == tc::for_each(tc_move_if_owned(rrng), no_adl::is_equal_elem<It, ItEnd, Pred>(it, tc_move(itEnd), pred)))) {
 			static_assert(!no_adl::is_unordered_range<tc::decay_t<RRng>>::value);
@@ -117,6 +124,15 @@ namespace tc{
 		requires(LRng const& lrng, RRng&& rrng){equal_impl::starts_with(tc::as_lvalue(tc::begin(lrng)), tc::as_const(tc::as_lvalue(tc::end(lrng))), tc_move_if_owned(rrng), std::declval<Pred>());}
 	[[nodiscard]] constexpr bool equal(LRng const& lrng, RRng&& rrng, Pred&& pred) MAYTHROW {
 		static_assert(!equal_impl::no_adl::is_unordered_range<tc::decay_t<LRng>>::value);
+		if constexpr( tc::simd_detail::contiguous_bitwise_comparable<LRng const&, RRng> && equal_impl::equality_pred<Pred> ) {
+			if( !std::is_constant_evaluated() ) {
+				auto const pLhs = std::to_address(tc::begin(lrng));
+				auto const nLhs = std::to_address(tc::end(lrng)) - pLhs;
+				auto const pRhs = std::to_address(tc::begin(rrng));
+				return nLhs == std::to_address(tc::end(rrng)) - pRhs
+					&& (0 == nLhs || 0 == std::memcmp(pLhs, pRhs, tc::explicit_cast<std::size_t>(nLhs) * sizeof(*pLhs)));
+			}
+		}
 		constexpr bool bHasSize=tc::has_size<LRng> && tc::has_size<RRng>;
 		if constexpr(bHasSize) {
 			if(tc::size(lrng)!=tc::size(rrng)) return false;
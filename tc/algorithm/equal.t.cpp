@@ -8,6 +8,10 @@
 
 #include "../base/assert_defs.h"
 #include "../unittest.h"
+#include "../container/container.h" // tc::vector
+#include "append.h"
+#include "compare.h"
+#include "longest_common_prefix.h"
 
 namespace {
 
@@ -134,3 +138,67 @@ static_assert(no_adl::has_assign_better<tc::fn_less, std::atomic<int>&, int, int
 static_assert(no_adl::has_assign_better<tc::fn_less, int&, int>::value);
 static_assert(no_adl::has_assign_better<tc::fn_less, int&, int, int>::value);
 }
+
+namespace {
+	template<typename T>
+	void test_equal_compare_vectorized() noexcept {
+		static_assert( tc::simd_detail::contiguous_bitwise_comparable<tc::vector<T> const&, tc::vector<T>&> );
+		for( int nSize = 0; nSize < 70; ++nSize ) {
+			tc::vector<T> vecLhs;
+			for( int i = 0; i < nSize; ++i ) tc::cont_emplace_back(vecLhs, tc::explicit_cast<T>(i % 50));
+			_ASSERT( tc::equal(vecLhs, vecLhs) );
+			_ASSERTEQUAL( tc::lexicographical_compare_3way(vecLhs, vecLhs), std::strong_ordering::equal );
+			for( int i = 0; i < nSize; ++i ) {
+				auto vecRhs = vecLhs;
+				vecRhs[i] = tc::explicit_cast<T>(vecRhs[i] + 1);
+				_ASSERT( !tc::equal(vecLhs, vecRhs) );
+				_ASSERTEQUAL( tc::lexicographical_compare_3way(vecLhs, vecRhs), std::strong_ordering::less );
+				_ASSERTEQUAL( tc::lexicographical_compare_3way(vecRhs, vecLhs), std::strong_ordering::greater );
+				_ASSERTEQUAL( tc::size(tc::longest_common_prefix<tc::return_take>(vecLhs, vecRhs).first), i );
+			}
+			if( 0 < nSize ) {
+				auto const vecPrefix = tc::make_vector(tc::begin_next<tc::return_take>(vecLhs, nSize - 1));
+				_ASSERT( !tc::equal(vecLhs, vecPrefix) );
+				_ASSERTEQUAL( tc::lexicographical_compare_3way(vecPrefix, vecLhs), std::strong_ordering::less );
+				_ASSERTEQUAL( tc::lexicographical_compare_3way(vecLhs, vecPrefix), std::strong_ordering::greater );
+				_ASSERTEQUAL( tc::lexicographical_compare_3way_prefixequivalence(vecPrefix, vecLhs), std::strong_ordering::equivalent );
+				_ASSERTEQUAL( tc::size(tc::longest_common_prefix<tc::return_take>(vecLhs, vecPrefix).first), nSize - 1 );
+			}
+		}
+	}
+}
+
+UNITTESTDEF( equal_compare_vectorized ) {
+	test_equal_compare_vectorized<unsigned char>();
+	test_equal_compare_vectorized<short>();
+	test_equal_compare_vectorized<unsigned int>();
+	test_equal_compare_vectorized<long long>();
+
+	// signed comparison of the mismatching element
+	_ASSERTEQUAL( tc::lexicographical_compare_3way(tc::vector<int>{1, -1}, tc::vector<int>{1, 1}), std::strong_ordering::less );
+	_ASSERT( tc::equal(tc::string<char>("abc"), "abc") );
+	_ASSERT( !tc::equal(tc::string<char>("abc"), "abcd") );
+}
+
+namespace {
+	enum class ELetter : unsigned char { a, b, A, B };
+	static_assert( tc::simd_detail::bitwise_comparable<ELetter> );
+
+	enum class ECaseInsensitive : unsigned char { a, b, A, B };
+	constexpr bool operator==(ECaseInsensitive const lhs, ECaseInsensitive const rhs) noexcept {
+		return tc::to_underlying(lhs) % 2 == tc::to_underlying(rhs) % 2;
+	}
+	constexpr std::strong_ordering operator<=>(ECaseInsensitive const lhs, ECaseInsensitive const rhs) noexcept {
+		return tc::to_underlying(lhs) % 2 <=> tc::to_underlying(rhs) % 2;
+	}
+	static_assert( !tc::simd_detail::bitwise_comparable<ECaseInsensitive> );
+}
+
+UNITTESTDEF( equal_compare_enum_with_operators ) {
+	using enum ECaseInsensitive;
+	tc::vector<ECaseInsensitive> const vecLhs{b, A};
+	tc::vector<ECaseInsensitive> const vecRhs{B, a};
+	_ASSERT( tc::equal(vecLhs, vecRhs) );
+	_ASSERTEQUAL( tc::lexicographical_compare_3way(vecLhs, vecRhs), std::strong_ordering::equal );
+	_ASSERTEQUAL( tc::size(tc::longest_common_prefix<tc::return_take>(vecLhs, vecRhs).first), 2 );
+}
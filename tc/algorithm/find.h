@@ -15,6 +15,11 @@
 #include "../storage_for.h"
 
 #include "equal.h"
+#include "simd.h"
+
+#include <memory>
+#include <optional>
+#include <utility>
 
 namespace tc {
 	namespace no_adl {
@@ -82,6 +87,66 @@ namespace tc {
 		}
 	}
 
+	namespace find_simd_detail {
+		template<typename Rng>
+		using element_t = std::remove_cv_t<tc::range_value_t<Rng>>;
+
+		// Searching for t in rng compares object representations, which vectorized kernels can do.
+		template<typename Rng, typename T>
+		concept vectorizable = tc::contiguous_range<Rng> && tc::common_range<Rng> && tc::simd_detail::bitwise_comparable<element_t<Rng>> && (
+			std::is_same<tc::decay_t<T>, element_t<Rng>>::value ||
+			(tc::actual_integer<element_t<Rng>> && tc::actual_integer<tc::decay_t<T>>)
+		);
+
+		// t as an element of rng, or std::nullopt if no element can be equal to t.
+		template<typename Rng, typename T>
+		constexpr std::optional<element_t<Rng>> as_element(T const& t) noexcept {
+			if constexpr( std::is_same<T, element_t<Rng>>::value ) {
+				return t;
+			} else if( std::in_range<element_t<Rng>>(t) ) {
+				return static_cast<element_t<Rng>>(t);
+			} else {
+				return std::nullopt;
+			}
+		}
+
+		template<typename RangeReturn, typename Rng>
+		[[nodiscard]] constexpr tc::element_return_type_t<RangeReturn, Rng> pack(Rng&& rng, element_t<Rng> const* const p) noexcept {
+			if( !p ) return RangeReturn::pack_no_element(std::forward<Rng>(rng));
+			auto it = tc::begin(rng) + (p - std::to_address(tc::begin(rng)));
+			if constexpr( RangeReturn::requires_iterator ) {
+				decltype(auto) ref = *it;
+				return RangeReturn::pack_element(tc_move(it), std::forward<Rng>(rng), tc_move_if_owned(ref));
+			} else {
+				return RangeReturn::template pack_element<Rng>(*it);
+			}
+		}
+
+		template<typename RangeReturn, IF_TC_CHECKS(bool c_bCheckUnique,) typename Rng, typename T>
+		[[nodiscard]] tc::element_return_type_t<RangeReturn, Rng> find_first(Rng&& rng, T const& t) noexcept {
+			element_t<Rng> const* p = nullptr;
+			if( auto const ot = as_element<Rng>(t) ) {
+				auto const pEnd = std::to_address(tc::end(rng));
+				p = tc::simd_detail::find_first_equal(std::to_address(tc::begin(rng)), pEnd, *ot);
+#ifdef _CHECKS
+				if constexpr( c_bCheckUnique ) {
+					_ASSERTE( !p || !tc::simd_detail::find_first_equal(p + 1, pEnd, *ot) );
+				}
+#endif
+			}
+			return find_simd_detail::pack<RangeReturn>(std::forward<Rng>(rng), p);
+		}
+
+		template<typename RangeReturn, typename Rng, typename T>
+		[[nodiscard]] tc::element_return_type_t<RangeReturn, Rng> find_last(Rng&& rng, T const& t) noexcept {
+			element_t<Rng> const* p = nullptr;
+			if( auto const ot = as_element<Rng>(t) ) {
+				p = tc::simd_detail::find_last_equal(std::to_address(tc::begin(rng)), std::to_address(tc::end(rng)), *ot);
+			}
+			return find_simd_detail::pack<RangeReturn>(std::forward<Rng>(rng), p);
+		}
+	}
+
 	template< typename RangeReturn, typename Rng, typename Pred = tc::identity >
 	[[nodiscard]] constexpr decltype(auto) find_first_if(Rng&& rng, Pred&& pred = Pred()) MAYTHROW {
 		return find_first_if_detail::find_first_if<RangeReturn IF_TC_CHECKS(, /*c_bCheckUnique*/false)>(std::forward<Rng>(rng), std::forward<Pred>(pred));
@@ -144,6 +209,11 @@ namespace tc {
 				!tc::has_key_type<std::remove_cvref_t<Rng>>::value,
 				"Do you want to use tc::cont_find?"
 			);
+			if constexpr( find_simd_detail::vectorizable<Rng, T> ) {
+				if( !std::is_constant_evaluated() ) {
+					return find_simd_detail::find_first<RangeReturn IF_TC_CHECKS(, c_bCheckUnique)>(std::forward<Rng>(rng), t);
+				}
+			}
 			return find_first_if_detail::find_first_if<RangeReturn IF_TC_CHECKS(, c_bCheckUnique)>(std::forward<Rng>(rng), [&](auto const& _) MAYTHROW { return tc::equal_to(_, t); });
 		}
 	}
@@ -161,6 +231,11 @@ namespace tc {
 
 	template< typename RangeReturn, typename Rng, typename T >
 	[[nodiscard]] constexpr decltype(auto) find_last(Rng&& rng, T const& t) noexcept {
+		if constexpr( find_simd_detail::vectorizable<Rng, T> ) {
+			if( !std::is_constant_evaluated() ) {
+				return find_simd_detail::find_last<RangeReturn>(std::forward<Rng>(rng), t);
+			}
+		}
 		return tc::find_last_if<RangeReturn>( std::forward<Rng>(rng), [&](auto const& _) noexcept { return tc::equal_to(_, t); } );
 	}
 }
@@ -0,0 +1,77 @@
+// think-cell public library
+//
+// Copyright (C) 2016-2023 think-cell Software GmbH
+//
+// Distributed under the Boost Software License, Version 1.0.
+// See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt
+
+#include "../base/assert_defs.h"
+#include "../container/container.h" // tc::vector
+#include "../unittest.h"
+#include "../range/iota_range.h"
+#include "../range/transform_adaptor.h"
+#include "append.h"
+#include "find.h"
+
+namespace {
+	enum class EColor { red, green, blue };
+
+	enum class ECaseInsensitive : unsigned char { a, b, A, B };
+	constexpr bool operator==(ECaseInsensitive const lhs, ECaseInsensitive const rhs) noexcept {
+		return tc::to_underlying(lhs) % 2 == tc::to_underlying(rhs) % 2;
+	}
+
+	template<typename T>
+	void test_find_vectorized() noexcept {
+		static_assert( tc::find_simd_detail::vectorizable<tc::vector<T>&, T> );
+		for( int nSize = 0; nSize < 80; ++nSize ) {
+			auto const vect = tc::make_vector(tc::transform(tc::iota(0, nSize), [](int const n) noexcept { return tc::explicit_cast<T>(n % 40); }));
+			for( int n = -1; n <= 40; ++n ) {
+				bool const bFound = 0 <= n && n < tc::min(nSize, 40);
+				auto const nFirst = bFound ? n : -1;
+				auto const nLast = bFound ? n + (nSize - 1 - n) / 40 * 40 : -1;
+				_ASSERTEQUAL(tc::find_first<tc::return_element_index_or_npos>(vect, n), nFirst);
+				_ASSERTEQUAL(tc::find_last<tc::return_element_index_or_npos>(vect, n), nLast);
+				_ASSERTEQUAL(tc::find_first<tc::return_bool>(vect, n), -1 != nFirst);
+			}
+		}
+	}
+}
+
+UNITTESTDEF( find_vectorized ) {
+	test_find_vectorized<signed char>();
+	test_find_vectorized<unsigned short>();
+	test_find_vectorized<int>();
+	test_find_vectorized<unsigned long long>();
+
+	// needle not representable in the element type
+	tc::vector<unsigned char> vecuch{0, 1, 44, 255};
+	_ASSERT( !tc::find_first<tc::return_bool>(vecuch, 300) );
+	_ASSERT( !tc::find_first<tc::return_bool>(vecuch, -1) );
+	_ASSERTEQUAL( tc::find_first<tc::return_element_index>(vecuch, 255), 3 );
+	_ASSERTEQUAL( tc::find_unique<tc::return_element_index>(vecuch, 44ll), 2 );
+
+	// element is returned by reference
+	tc::vector<int> vecn{1, 2, 3, 2};
+	*tc::find_last<tc::return_element>(vecn, 2) = 5;
+	_ASSERTEQUAL( vecn, (tc::vector<int>{1, 2, 3, 5}) );
+
+	auto const str = tc::string<char>("The quick brown fox jumps over the lazy dog");
+	_ASSERTEQUAL( tc::find_first<tc::return_element_index>(str, 'z'), 37 );
+	_ASSERTEQUAL( tc::find_last<tc::return_element_index>(str, 'o'), 41 );
+
+	tc::vector<EColor> vececolor{EColor::red, EColor::green, EColor::red};
+	_ASSERTEQUAL( tc::find_last<tc::return_element_index>(vececolor, EColor::red), 2 );
+	_ASSERT( !tc::find_first<tc::return_bool>(vececolor, EColor::blue) );
+
+	static_assert( tc::find_first<tc::return_bool>(std::array<int, 3>{1, 2, 3}, 2) );
+
+	// the overloaded operator== is used for every range length
+	static_assert( !tc::find_simd_detail::vectorizable<tc::vector<ECaseInsensitive>&, ECaseInsensitive> );
+	for( int nSize : {2, 64} ) {
+		auto const vecenum = tc::make_vector(tc::transform(tc::iota(0, nSize), [](int) noexcept { return ECaseInsensitive::a; }));
+		_ASSERT( tc::find_first<tc::return_bool>(vecenum, ECaseInsensitive::A) );
+		_ASSERTEQUAL( tc::find_last<tc::return_element_index>(vecenum, ECaseInsensitive::A), nSize - 1 );
+		_ASSERT( !tc::find_first<tc::return_bool>(vecenum, ECaseInsensitive::B) );
+	}
+}
@@ -10,6 +10,8 @@
 
 #include "equal.h"
 
+#include <memory>
+
 namespace tc {
 	template< typename RangeReturn, typename RngLhs, typename RngRhs, typename Pred=tc::fn_equal_to_or_parse_match>
 	[[nodiscard]] constexpr decltype(auto) longest_common_prefix(RngLhs&& rnglhs, RngRhs&& rngrhs, Pred pred=Pred()) MAYTHROW {
@@ -19,6 +21,21 @@ namespace tc {
 		tc_auto_cref(itrhsEnd, tc::end(rngrhs));
 		auto itlhs=tc::begin(rnglhs);
 		auto itrhs=tc::begin(rngrhs);
+		if constexpr( tc::simd_detail::contiguous_bitwise_comparable<RngLhs&, RngRhs&> && equal_impl::equality_pred<Pred> ) {
+			if( !std::is_constant_evaluated() ) {
+				auto const n = tc::simd_detail::mismatch(
+					std::to_address(itlhs),
+					std::to_address(itrhs),
+					tc::explicit_cast<std::size_t>(tc::min(itlhsEnd - itlhs, itrhsEnd - itrhs))
+				);
+				itlhs += n;
+				itrhs += n;
+				return std::make_pair(
+					RangeReturn::pack_border(itlhs, std::forward<RngLhs>(rnglhs)),
+					RangeReturn::pack_border(itrhs, std::forward<RngRhs>(rngrhs))
+				);
+			}
+		}
 		while(itlhs < itlhsEnd && itrhs < itrhsEnd && tc::invoke(pred, *itlhs, *itrhs)) {
 			++itlhs;
 			++itrhs;
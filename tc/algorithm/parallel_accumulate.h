@@ -0,0 +1,123 @@
+// think-cell public library
+//
+// Copyright (C) 2016-2023 think-cell Software GmbH
+//
+// Distributed under the Boost Software License, Version 1.0.
+// See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt
+
+#pragma once
+
+#include "../base/assert_defs.h"
+#include "../base/assign.h"
+#include "../base/functors.h"
+#include "../base/utility.h"
+#include "../thread_pool.h"
+
+#include "accumulate.h"
+#include "parallel_for_each.h"
+
+#include <concepts>
+#include <iterator>
+#include <optional>
+
+namespace tc {
+	// Accumulation operators can be marked as associative by an ADL-visible declaration
+	//  tc::constant<true> is_associative(Op) noexcept;
+	// which allows tc::accumulate(tc::par, ...) to fold parts of a range independently.
+	namespace no_adl {
+		tc::constant<true> is_associative(tc::fn_assign_plus) noexcept;
+		tc::constant<true> is_associative(tc::fn_assign_mul) noexcept;
+		tc::constant<true> is_associative(tc::fn_assign_bit_or) noexcept;
+		tc::constant<true> is_associative(tc::fn_assign_bit_and) noexcept;
+	}
+	tc::constant<true> is_associative(tc::fn_assign_min) noexcept;
+	tc::constant<true> is_associative(tc::fn_assign_max) noexcept;
+
+	namespace parallel_accumulate_detail {
+		tc::constant<false> is_associative(tc::unused) noexcept;
+
+		template<typename AccuOp>
+		concept associative = decltype(is_associative(std::declval<AccuOp const&>()))::value; // invoke ADL
+
+		inline constexpr std::size_t c_nBlockSize = 1 << 14;
+		inline constexpr std::size_t c_nPairwiseBaseSize = 128;
+
+		// Summing floating point numbers pairwise, the rounding error grows with O(log n) instead of O(n).
+		template<typename T, typename AccuOp>
+		concept pairwise_summation = std::floating_point<T> && std::is_same<AccuOp, tc::fn_assign_plus>::value;
+
+		template<typename T, typename It, typename AccuOp>
+		T fold(It const itBegin, std::size_t const n, AccuOp const& accuop) MAYTHROW {
+			_ASSERTE( 0 < n );
+			if constexpr( pairwise_summation<T, AccuOp> ) {
+				if( c_nPairwiseBaseSize < n ) {
+					auto const nLeft = n / 2;
+					T t = parallel_accumulate_detail::fold<T>(itBegin, nLeft, accuop);
+					t += parallel_accumulate_detail::fold<T>(itBegin + tc::explicit_cast<std::iter_difference_t<It>>(nLeft), n - nLeft, accuop);
+					return t;
+				}
+			}
+			auto it = itBegin;
+			T t(*it); // MAYTHROW
+			for( std::size_t i = 1; i < n; ++i ) {
+				accuop(t, *++it); // MAYTHROW
+			}
+			return t;
+		}
+
+		// The tree of partial results only depends on n, so results are reproducible, no matter how many threads compute them.
+		template<typename T, typename It, typename AccuOp>
+		T reduce(tc::thread_pool& threadpool, It const itBegin, std::size_t const n, AccuOp const& accuop) MAYTHROW {
+			if( n <= c_nBlockSize ) return parallel_accumulate_detail::fold<T>(itBegin, n, accuop); // MAYTHROW
+			auto const nLeft = (n + c_nBlockSize - 1) / c_nBlockSize / 2 * c_nBlockSize;
+			std::optional<T> otLeft;
+			std::optional<T> otRight;
+			tc::parallel_invoke(
+				threadpool,
+				[&]() MAYTHROW { otLeft.emplace(parallel_accumulate_detail::reduce<T>(threadpool, itBegin, nLeft, accuop)); },
+				[&]() MAYTHROW { otRight.emplace(parallel_accumulate_detail::reduce<T>(threadpool, itBegin + tc::explicit_cast<std::iter_difference_t<It>>(nLeft), n - nLeft, accuop)); }
+			); // MAYTHROW
+			accuop(*otLeft, tc_move_always(*otRight)); // MAYTHROW
+			return *tc_move_always(otLeft);
+		}
+	}
+
+	// Parallel accumulate with an associative accuop, e.g., tc::fn_assign_plus, tc::fn_assign_min or tc::fn_assign_bit_or.
+	// Random-access ranges with known size are cut into blocks that are folded on tc::default_thread_pool(), and the partial
+	// results of adjacent blocks are combined with accuop in a binary tree. Both depend only on the size of the range,
+	// so the result is the same on every machine, and for integers the same as with tc::accumulate.
+	// Floating point numbers are summed pairwise, which is more accurate than tc::accumulate.
+	// All other ranges are accumulated sequentially.
+	//  * T must be constructible from the elements of rng, and accuop(T&, T&&) must combine partial results
+	//  * accuop must not return tc::break_
+	template<typename Rng, typename T, parallel_accumulate_detail::associative AccuOp>
+	[[nodiscard]] T accumulate(tc::par_t, Rng&& rng, T t, AccuOp accuop) MAYTHROW {
+		if constexpr( parallel_for_each_detail::splittable<Rng> ) {
+			if( auto const n = tc::explicit_cast<std::size_t>(tc::size_raw(rng)); 0 < n ) {
+				accuop(t, parallel_accumulate_detail::reduce<T>(tc::default_thread_pool(), tc::begin(rng), n, tc::as_const(accuop))); // MAYTHROW
+			}
+			return t;
+		} else {
+			return tc::accumulate(std::forward<Rng>(rng), tc_move(t), tc_move(accuop)); // MAYTHROW
+		}
+	}
+
+	template<typename T, typename Rng, parallel_accumulate_detail::associative AccuOp>
+	[[nodiscard]] std::optional<T> accumulate_with_front(tc::par_t, Rng&& rng, AccuOp accuop) MAYTHROW {
+		static_assert(tc::decayed<T>);
+		if constexpr( parallel_for_each_detail::splittable<Rng> ) {
+			if( auto const n = tc::explicit_cast<std::size_t>(tc::size_raw(rng)); 0 < n ) {
+				return parallel_accumulate_detail::reduce<T>(tc::default_thread_pool(), tc::begin(rng), n, tc::as_const(accuop)); // MAYTHROW
+			} else {
+				return std::nullopt;
+			}
+		} else {
+			return tc::accumulate_with_front<T>(std::forward<Rng>(rng), tc_move(accuop)); // MAYTHROW
+		}
+	}
+
+	template<typename Rng, parallel_accumulate_detail::associative AccuOp>
+	[[nodiscard]] auto accumulate_with_front(tc::par_t, Rng&& rng, AccuOp accuop) MAYTHROW {
+		return tc::accumulate_with_front<tc::range_value_t<Rng>>(tc::par, std::forward<Rng>(rng), tc_move(accuop));
+	}
+}
@@ -0,0 +1,80 @@
+// think-cell public library
+//
+// Copyright (C) 2016-2023 think-cell Software GmbH
+//
+// Distributed under the Boost Software License, Version 1.0.
+// See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt
+
+#include "../base/assert_defs.h"
+#include "../unittest.h"
+#include "../range/iota_range.h"
+#include "../range/filter_adaptor.h"
+#include "../range/transform.h"
+#include "../container/insert.h"
+#include "parallel_accumulate.h"
+
+#include <cmath>
+
+namespace {
+	// x -> m_nMul * x + m_nAdd modulo a prime
+	struct affine final {
+		long long m_nMul;
+		long long m_nAdd;
+
+		friend bool operator==(affine const&, affine const&) = default;
+	};
+
+	// composition of functions is associative, but not commutative
+	struct compose final {
+		void operator()(affine& lhs, affine const& rhs) const& noexcept {
+			constexpr long long c_nPrime = 1000003;
+			lhs = {rhs.m_nMul * lhs.m_nMul % c_nPrime, (rhs.m_nMul * lhs.m_nAdd + rhs.m_nAdd) % c_nPrime};
+		}
+		friend tc::constant<true> is_associative(compose) noexcept;
+	};
+
+	static_assert(tc::parallel_accumulate_detail::associative<tc::fn_assign_plus>);
+	static_assert(tc::parallel_accumulate_detail::associative<tc::fn_assign_min>);
+	static_assert(tc::parallel_accumulate_detail::associative<compose>);
+	static_assert(!tc::parallel_accumulate_detail::associative<tc::fn_assign_minus>);
+}
+
+UNITTESTDEF(parallel_accumulate) {
+	tc::vector<int> vecn;
+	for( int i = 0; i < 1000000; ++i ) tc::cont_emplace_back(vecn, tc::explicit_cast<int>(i * 7919ll % 100003) - 50000);
+
+	_ASSERTEQUAL(tc::accumulate(tc::par, vecn, 0ll, tc::fn_assign_plus()), tc::accumulate(vecn, 0ll, tc::fn_assign_plus()));
+	_ASSERTEQUAL(tc::accumulate(tc::par, vecn, 5, tc::fn_assign_bit_or()), tc::accumulate(vecn, 5, tc::fn_assign_bit_or()));
+	_ASSERTEQUAL(*tc::accumulate_with_front(tc::par, vecn, tc::fn_assign_min()), -50000);
+	_ASSERTEQUAL(*tc::accumulate_with_front(tc::par, tc::iota(0, 100000), tc::fn_assign_max()), 99999);
+	_ASSERTEQUAL(
+		tc::accumulate(tc::par, tc::transform(vecn, [](int const n) noexcept { return 2ll * n; }), 0ll, tc::fn_assign_plus()),
+		2 * tc::accumulate(vecn, 0ll, tc::fn_assign_plus())
+	);
+
+	// the order of elements is kept
+	auto const rngaffine = tc::transform(tc::iota(0, 100000), [](int const n) noexcept { return affine{n % 7 + 1, n}; });
+	_ASSERT(tc::accumulate(tc::par, rngaffine, affine{1, 0}, compose()) == tc::accumulate(rngaffine, affine{1, 0}, compose()));
+
+	// empty and non-splittable ranges
+	_ASSERTEQUAL(tc::accumulate(tc::par, tc::vector<int>(), 3, tc::fn_assign_plus()), 3);
+	_ASSERT(!tc::accumulate_with_front(tc::par, tc::vector<int>(), tc::fn_assign_plus()));
+	auto const rngnOdd = tc::filter(vecn, [](int const n) noexcept { return 0 != n % 2; });
+	_ASSERTEQUAL(tc::accumulate(tc::par, rngnOdd, 0ll, tc::fn_assign_plus()), tc::accumulate(rngnOdd, 0ll, tc::fn_assign_plus()));
+}
+
+UNITTESTDEF(parallel_accumulate_floating_point) {
+	tc::vector<float> vecf(1 << 22, 0.1f);
+	auto const f = tc::accumulate(tc::par, vecf, 0.0f, tc::fn_assign_plus());
+	// pairwise summation is much closer to the exact sum than the sequential one
+	auto const fExact = 0.1 * (1 << 22);
+	_ASSERT(std::abs(f - fExact) < 1e-4 * fExact);
+	_ASSERT(std::abs(f - fExact) < std::abs(tc::accumulate(vecf, 0.0f, tc::fn_assign_plus()) - fExact));
+
+	// and the result does not depend on the number of threads
+	tc::vector<double> vecd;
+	for( int i = 0; i < 100000; ++i ) tc::cont_emplace_back(vecd, 1.0 / (1 + i % 977));
+	auto const d = *tc::accumulate_with_front(tc::par, vecd, tc::fn_assign_plus());
+	tc::thread_pool threadpool(0);
+	_ASSERTEQUAL(tc::parallel_accumulate_detail::reduce<double>(threadpool, tc::begin(vecd), tc::size_raw(vecd), tc::fn_assign_plus()), d);
+}
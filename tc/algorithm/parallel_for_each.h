@@ -0,0 +1,120 @@
+// think-cell public library
+//
+// Copyright (C) 2016-2023 think-cell Software GmbH
+//
+// Distributed under the Boost Software License, Version 1.0.
+// See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt
+
+#pragma once
+
+#include "../base/assert_defs.h"
+#include "../base/tag_type.h"
+#include "../range/subrange.h"
+#include "../range/transform_adaptor.h"
+#include "../range/filter_adaptor.h"
+#include "../thread_pool.h"
+
+#include "for_each.h"
+#include "size.h"
+
+#include <exception>
+
+namespace tc {
+	DEFINE_TAG_TYPE(par) // parallel execution policy, tc::for_each(tc::par, rng, sink)
+
+	namespace parallel_for_each_detail {
+		inline constexpr std::size_t c_nMinBlockSize = 1024;
+		inline constexpr std::size_t c_nBlocksPerWorker = 4; // allows work stealing to balance blocks of uneven cost
+
+		template<typename Rng>
+		concept splittable = tc::random_access_range<Rng> && tc::has_size<Rng>;
+
+		// Adaptors whose adapted sink can be applied independently to every element of the base range.
+		// Order-dependent adaptors (take_while, unique, partial_sum, ...) must not be listed here.
+		template<typename Rng>
+		concept forwards_split_to_base_range =
+			tc::instance2<std::remove_cvref_t<Rng>, tc::transform_adaptor> ||
+			tc::instance2<std::remove_cvref_t<Rng>, tc::filter_adaptor>;
+
+		namespace no_adl {
+			// Stops at the next element once any block has broken or thrown.
+			template<typename Sink>
+			struct cancellable_sink final {
+				Sink const& m_sink;
+				std::atomic<bool>& m_bBreak;
+
+				template<typename T>
+				tc::break_or_continue operator()(T&& t) const& MAYTHROW {
+					if( m_bBreak.load(std::memory_order_relaxed) ) return tc::break_;
+					if( tc::break_ == tc::continue_if_not_break(m_sink, std::forward<T>(t)) ) { // MAYTHROW
+						m_bBreak.store(true, std::memory_order_relaxed);
+						return tc::break_;
+					}
+					return tc::continue_;
+				}
+			};
+		}
+		using no_adl::cancellable_sink;
+
+		template<typename Rng, typename Sink>
+		auto for_each_split(Rng& rng, Sink const& sink) MAYTHROW {
+			using result_t = tc::common_type_t<decltype(tc::for_each(rng, sink)), tc::constant<tc::continue_>>;
+			auto& threadpool = tc::default_thread_pool();
+			auto const n = tc::size_raw(rng);
+			auto const nBlocks = tc::min(
+				(tc::explicit_cast<std::size_t>(n) + c_nMinBlockSize - 1) / c_nMinBlockSize,
+				threadpool.worker_count() * c_nBlocksPerWorker + 1 // the calling thread works, too
+			);
+			if( nBlocks <= 1 ) return tc::implicit_cast<result_t>(tc::for_each(rng, sink)); // MAYTHROW
+
+			std::atomic<bool> bBreak{false};
+			auto const itBegin = tc::begin(rng);
+			auto RunBlock = [&](std::size_t const iBlock) MAYTHROW {
+				if( bBreak.load(std::memory_order_relaxed) ) return;
+				auto Offset = [&](std::size_t const i) noexcept {
+					return tc::explicit_cast<typename boost::range_difference<Rng>::type>(tc::explicit_cast<std::size_t>(n) * i / nBlocks);
+				};
+				tc::decay_t<Sink> const sinkBlock = sink; // every block works on its own copy of the sink
+				try {
+					tc::for_each(
+						tc::slice(rng, itBegin + Offset(iBlock), itBegin + Offset(iBlock + 1)),
+						cancellable_sink<tc::decay_t<Sink>>{sinkBlock, bBreak}
+					); // MAYTHROW
+				} catch(...) {
+					bBreak.store(true, std::memory_order_relaxed);
+					throw;
+				}
+			};
+			tc::task_group taskgroup(threadpool);
+			for( std::size_t iBlock = 1; iBlock < nBlocks; ++iBlock ) {
+				taskgroup.run([&RunBlock, iBlock]() MAYTHROW { RunBlock(iBlock); });
+			}
+			RunBlock(0); // MAYTHROW, the destructor of taskgroup waits for the other blocks
+			taskgroup.wait(); // MAYTHROW
+
+			if constexpr( std::is_same<result_t, tc::constant<tc::continue_>>::value ) {
+				return result_t();
+			} else {
+				return tc::implicit_cast<result_t>(tc::continue_if(!bBreak.load(std::memory_order_relaxed)));
+			}
+		}
+	}
+
+	// Parallel for_each. Random-access ranges with known size are cut into blocks that run on tc::default_thread_pool(),
+	// tc::transform and tc::filter pass the split on to their base range. All other ranges are iterated sequentially.
+	//  * the sink is copied per block and may be called concurrently, so its operator() const must be thread-safe
+	//  * elements are visited in unspecified order
+	//  * break_ is cooperative: the other blocks stop before their next element, and break_ is returned.
+	//    Elements not preceding the breaking element may have been visited already.
+	//  * an exception thrown by the sink cancels the other blocks in the same way and is rethrown after all blocks finished
+	template<typename Rng, typename Sink>
+	auto for_each(tc::par_t, Rng&& rng, Sink&& sink) MAYTHROW {
+		if constexpr( parallel_for_each_detail::forwards_split_to_base_range<Rng> ) {
+			return tc::for_each(tc::par, rng.base_range(), rng.adapted_sink(std::forward<Sink>(sink), /*bReverse*/tc::constant<false>()));
+		} else if constexpr( parallel_for_each_detail::splittable<Rng> ) {
+			return parallel_for_each_detail::for_each_split(rng, tc::as_const(tc::as_lvalue(tc::decay_copy(std::forward<Sink>(sink)))));
+		} else {
+			return tc::for_each(std::forward<Rng>(rng), std::forward<Sink>(sink));
+		}
+	}
+}
@@ -0,0 +1,69 @@
+// think-cell public library
+//
+// Copyright (C) 2016-2023 think-cell Software GmbH
+//
+// Distributed under the Boost Software License, Version 1.0.
+// See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt
+
+#include "../base/assert_defs.h"
+#include "../unittest.h"
+#include "../range/iota_range.h"
+#include "../container/insert.h"
+#include "parallel_for_each.h"
+
+UNITTESTDEF( parallel_for_each ) {
+	tc::vector<int> vecn;
+	for( int i = 0; i < 100000; ++i ) tc::cont_emplace_back(vecn, i);
+
+	{
+		std::atomic<long long> nSum = 0;
+		STATICASSERTSAME(decltype(tc::for_each(tc::par, vecn, [&](int const n) noexcept { nSum += n; })), tc::constant<tc::continue_>);
+		tc::for_each(tc::par, vecn, [&](int const n) noexcept { nSum += n; });
+		_ASSERTEQUAL(nSum.load(), 100000ll * 99999 / 2);
+	}
+	{
+		// the split is forwarded through transform and filter to the vector
+		std::atomic<long long> nSum = 0;
+		tc::for_each(
+			tc::par,
+			tc::filter(tc::transform(vecn, [](int const n) noexcept { return 2 * n; }), [](int const n) noexcept { return 0 == n % 3; }),
+			[&](int const n) noexcept { nSum += n; }
+		);
+		long long nSumExpected = 0;
+		tc::for_each(vecn, [&](int const n) noexcept { if( 0 == 2 * n % 3 ) nSumExpected += 2 * n; });
+		_ASSERTEQUAL(nSum.load(), nSumExpected);
+	}
+	{
+		std::atomic<int> nCount = 0;
+		tc::for_each(tc::par, tc::iota(0, 50000), [&](int) noexcept { ++nCount; });
+		_ASSERTEQUAL(nCount.load(), 50000);
+	}
+	{
+		// break_ cancels the remaining blocks
+		std::atomic<int> nCount = 0;
+		_ASSERTEQUAL(tc::break_, tc::for_each(tc::par, vecn, [&](int const n) noexcept {
+			++nCount;
+			return tc::continue_if(n != 10);
+		}));
+		_ASSERT(nCount.load() < 100000);
+		_ASSERTEQUAL(tc::continue_, tc::for_each(tc::par, vecn, [](int) noexcept { return tc::continue_; }));
+	}
+	{
+		// elements are mutable
+		tc::vector<int> vecnCopy = vecn;
+		tc::for_each(tc::par, vecnCopy, [](int& n) noexcept { n *= 2; });
+		_ASSERT(tc::equal(vecnCopy, tc::transform(vecn, [](int const n) noexcept { return 2 * n; })));
+	}
+	{
+		// exceptions are propagated to the caller
+		bool bCaught = false;
+		try {
+			tc::for_each(tc::par, vecn, [](int const n) MAYTHROW {
+				if( 50000 == n ) throw 0;
+			});
+		} catch(int) {
+			bCaught = true;
+		}
+		_ASSERT(bCaught);
+	}
+}
@@ -0,0 +1,143 @@
+// think-cell public library
+//
+// Copyright (C) 2016-2023 think-cell Software GmbH
+//
+// Distributed under the Boost Software License, Version 1.0.
+// See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt
+
+#pragma once
+
+#include "../base/assert_defs.h"
+#include "../range/partial_sum.h"
+#include "../container/container.h"
+#include "../thread_pool.h"
+
+#include "append.h"
+#include "element.h"
+#include "parallel_accumulate.h"
+#include "simd.h"
+
+#include <concepts>
+#include <iterator>
+#include <optional>
+
+// Materialized partial sums, which tc::partial_sum_excluding_init computes lazily.
+namespace tc {
+	namespace partial_sum_detail {
+		inline constexpr std::size_t c_nBlockSize = 1 << 16;
+
+		// Writes the partial sums of [itSrc, itSrc + n), starting from accu, to [itDst, itDst + n), which may be [itSrc, itSrc + n).
+		// Returns the last partial sum.
+		template<typename T, typename ItSrc, typename ItDst, typename AccuOp>
+		T scan(ItSrc itSrc, ItDst itDst, std::size_t const n, T accu, AccuOp const& accuop) MAYTHROW {
+			if constexpr(
+				std::contiguous_iterator<ItSrc> && std::contiguous_iterator<ItDst> &&
+				std::is_same<AccuOp, tc::fn_assign_plus>::value &&
+				tc::simd_detail::scannable_integer<T> &&
+				std::is_same<std::iter_value_t<ItSrc>, T>::value &&
+				std::is_same<std::iter_value_t<ItDst>, T>::value && !std::is_const<std::remove_reference_t<std::iter_reference_t<ItDst>>>::value
+			) {
+				return tc::simd_detail::inclusive_scan_plus(std::to_address(itSrc), std::to_address(itDst), n, accu);
+			} else {
+				for( std::size_t i = 0; i < n; ++i, ++itSrc, ++itDst ) {
+					accuop(accu, *itSrc); // MAYTHROW
+					*itDst = tc::as_const(accu); // MAYTHROW
+				}
+				return accu;
+			}
+		}
+
+		// Two passes over blocks of the range: the first one sums up every block, except for the first one, which is scanned right away,
+		// and the last one. After adding up the sums of the blocks before it, the second pass scans every block.
+		template<typename T, typename ItSrc, typename ItDst, typename AccuOp>
+		T parallel_scan(tc::thread_pool& threadpool, ItSrc const itSrc, ItDst const itDst, std::size_t const n, T accu, AccuOp const& accuop) MAYTHROW {
+			auto const nBlocks = (n + c_nBlockSize - 1) / c_nBlockSize;
+			if( nBlocks <= 1 ) return partial_sum_detail::scan(itSrc, itDst, n, tc_move(accu), accuop); // MAYTHROW
+
+			auto Src = [&](std::size_t const iBlock) noexcept { return itSrc + tc::explicit_cast<std::iter_difference_t<ItSrc>>(iBlock * c_nBlockSize); };
+			auto Dst = [&](std::size_t const iBlock) noexcept { return itDst + tc::explicit_cast<std::iter_difference_t<ItDst>>(iBlock * c_nBlockSize); };
+
+			tc::vector<std::optional<T>> vecotAccu(nBlocks - 1); // partial sum before block i + 1
+			{
+				tc::task_group taskgroup(threadpool);
+				for( std::size_t iBlock = 1; iBlock < nBlocks - 1; ++iBlock ) {
+					taskgroup.run([&, iBlock]() MAYTHROW {
+						tc::at(vecotAccu, iBlock).emplace(parallel_accumulate_detail::fold<T>(Src(iBlock), c_nBlockSize, accuop)); // MAYTHROW
+					});
+				}
+				tc::front(vecotAccu).emplace(partial_sum_detail::scan(itSrc, itDst, c_nBlockSize, tc_move(accu), accuop)); // MAYTHROW
+				taskgroup.wait(); // MAYTHROW
+			}
+			for( std::size_t iBlock = 1; iBlock < nBlocks - 1; ++iBlock ) {
+				T t = *tc::at(vecotAccu, iBlock - 1);
+				accuop(t, tc_move_always(*tc::at(vecotAccu, iBlock))); // MAYTHROW
+				tc::at(vecotAccu, iBlock).emplace(tc_move(t));
+			}
+			{
+				tc::task_group taskgroup(threadpool);
+				for( std::size_t iBlock = 1; iBlock < nBlocks - 1; ++iBlock ) {
+					taskgroup.run([&, iBlock]() MAYTHROW {
+						partial_sum_detail::scan(Src(iBlock), Dst(iBlock), c_nBlockSize, *tc::at(vecotAccu, iBlock - 1), accuop); // MAYTHROW
+					});
+				}
+				accu = partial_sum_detail::scan(Src(nBlocks - 1), Dst(nBlocks - 1), n - (nBlocks - 1) * c_nBlockSize, *tc::back(vecotAccu), accuop); // MAYTHROW
+				taskgroup.wait(); // MAYTHROW
+			}
+			return accu;
+		}
+
+		template<typename Rng>
+		concept scannable = tc::range_with_iterators<Rng> && tc::has_size<Rng>;
+	}
+
+	// Replaces every element of rng by the partial sum up to and including it, starting from init, i.e., by the elements
+	// of tc::partial_sum_excluding_init(rng, init, accuop). Returns the sum of all elements.
+	// Contiguous 32 and 64-bit integers are summed with SIMD instructions, wrapping around on overflow.
+	template<typename Rng, typename T, typename AccuOp = tc::fn_assign_plus> requires (!std::is_same<tc::decay_t<Rng>, tc::par_t>::value)
+	tc::decay_t<T> partial_sum_inplace(Rng&& rng, T&& init, AccuOp const& accuop = AccuOp()) MAYTHROW {
+		if constexpr( partial_sum_detail::scannable<Rng> ) {
+			return partial_sum_detail::scan(tc::begin(rng), tc::begin(rng), tc::explicit_cast<std::size_t>(tc::size_raw(rng)), tc::decay_copy(std::forward<T>(init)), accuop); // MAYTHROW
+		} else {
+			tc::decay_t<T> accu = std::forward<T>(init);
+			tc::for_each(rng, [&](auto& t) MAYTHROW {
+				accuop(accu, t); // MAYTHROW
+				t = tc::as_const(accu); // MAYTHROW
+			});
+			return accu;
+		}
+	}
+
+	// Parallel version for associative accuop: random-access ranges with known size are scanned in two passes over blocks,
+	// which run on tc::default_thread_pool(). For integers, the results are the same as with the sequential version.
+	template<typename Rng, typename T, parallel_accumulate_detail::associative AccuOp = tc::fn_assign_plus>
+	tc::decay_t<T> partial_sum_inplace(tc::par_t, Rng&& rng, T&& init, AccuOp const& accuop = AccuOp()) MAYTHROW {
+		if constexpr( parallel_for_each_detail::splittable<Rng> ) {
+			return partial_sum_detail::parallel_scan(tc::default_thread_pool(), tc::begin(rng), tc::begin(rng), tc::explicit_cast<std::size_t>(tc::size_raw(rng)), tc::decay_copy(std::forward<T>(init)), accuop); // MAYTHROW
+		} else {
+			return tc::partial_sum_inplace(std::forward<Rng>(rng), std::forward<T>(init), accuop); // MAYTHROW
+		}
+	}
+
+	// tc::make_vector(tc::partial_sum_excluding_init(rng, init, accuop)), using the same optimizations as tc::partial_sum_inplace.
+	template<typename Rng, typename T, typename AccuOp = tc::fn_assign_plus> requires (!std::is_same<tc::decay_t<Rng>, tc::par_t>::value)
+	[[nodiscard]] tc::vector<tc::decay_t<T>> make_partial_sum(Rng&& rng, T&& init, AccuOp const& accuop = AccuOp()) MAYTHROW {
+		if constexpr( partial_sum_detail::scannable<Rng> && std::default_initializable<tc::decay_t<T>> ) {
+			tc::vector<tc::decay_t<T>> vec(tc::explicit_cast<std::size_t>(tc::size_raw(rng)));
+			partial_sum_detail::scan(tc::begin(rng), tc::begin(vec), tc::size_raw(vec), tc::decay_copy(std::forward<T>(init)), accuop); // MAYTHROW
+			return vec;
+		} else {
+			return tc::make_vector(tc::partial_sum_excluding_init(std::forward<Rng>(rng), std::forward<T>(init), accuop)); // MAYTHROW
+		}
+	}
+
+	template<typename Rng, typename T, parallel_accumulate_detail::associative AccuOp = tc::fn_assign_plus>
+	[[nodiscard]] tc::vector<tc::decay_t<T>> make_partial_sum(tc::par_t, Rng&& rng, T&& init, AccuOp const& accuop = AccuOp()) MAYTHROW {
+		if constexpr( parallel_for_each_detail::splittable<Rng> && std::default_initializable<tc::decay_t<T>> ) {
+			tc::vector<tc::decay_t<T>> vec(tc::explicit_cast<std::size_t>(tc::size_raw(rng)));
+			partial_sum_detail::parallel_scan(tc::default_thread_pool(), tc::begin(rng), tc::begin(vec), tc::size_raw(vec), tc::decay_copy(std::forward<T>(init)), accuop); // MAYTHROW
+			return vec;
+		} else {
+			return tc::make_partial_sum(std::forward<Rng>(rng), std::forward<T>(init), accuop); // MAYTHROW
+		}
+	}
+}
@@ -0,0 +1,86 @@
+// think-cell public library
+//
+// Copyright (C) 2016-2023 think-cell Software GmbH
+//
+// Distributed under the Boost Software License, Version 1.0.
+// See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt
+
+#include "../base/assert_defs.h"
+#include "../unittest.h"
+#include "../range/filter_adaptor.h"
+#include "../container/insert.h"
+#include "partial_sum.h"
+
+namespace {
+	template<typename T>
+	tc::vector<T> make_test_data(int const n) noexcept {
+		tc::vector<T> vec;
+		for( int i = 0; i < n; ++i ) tc::cont_emplace_back(vec, tc::explicit_cast<T>(i * 7919ll % 100003 - 50000));
+		return vec;
+	}
+
+	template<typename T>
+	void test_partial_sum(int const n, T const init) noexcept {
+		auto const vec = make_test_data<T>(n);
+		auto const vecExpected = tc::make_vector(tc::partial_sum_excluding_init(vec, init, tc::fn_assign_plus()));
+
+		TEST_RANGE_EQUAL(tc::make_partial_sum(vec, init), vecExpected);
+		TEST_RANGE_EQUAL(tc::make_partial_sum(tc::par, vec, init), vecExpected);
+
+		auto vecInplace = vec;
+		_ASSERTEQUAL(tc::partial_sum_inplace(vecInplace, init), tc::empty(vecExpected) ? init : tc::back(vecExpected));
+		TEST_RANGE_EQUAL(vecInplace, vecExpected);
+
+		auto vecParInplace = vec;
+		_ASSERTEQUAL(tc::partial_sum_inplace(tc::par, vecParInplace, init), tc::empty(vecExpected) ? init : tc::back(vecExpected));
+		TEST_RANGE_EQUAL(vecParInplace, vecExpected);
+	}
+}
+
+UNITTESTDEF(partial_sum_materialized) {
+	for( int n = 0; n < 20; ++n ) {
+		test_partial_sum<int>(n, 0);
+		test_partial_sum<long long>(n, 7);
+		test_partial_sum<unsigned int>(n, 3);
+		test_partial_sum<double>(n, 0.5);
+	}
+	for( int n : {(1 << 16) - 1, 1 << 16, (1 << 16) + 1, 5 * (1 << 16) + 123} ) {
+		test_partial_sum<int>(n, -5);
+		test_partial_sum<long long>(n, 1ll << 40);
+		test_partial_sum<unsigned long long>(n, 0);
+	}
+}
+
+UNITTESTDEF(partial_sum_materialized_wraps_around) {
+	tc::vector<unsigned int> vecn(1000, 0xfffffff0u);
+	auto const vecnExpected = tc::make_vector(tc::partial_sum_excluding_init(vecn, 1u, tc::fn_assign_plus()));
+	TEST_RANGE_EQUAL(tc::make_partial_sum(vecn, 1u), vecnExpected);
+	_ASSERTEQUAL(tc::partial_sum_inplace(vecn, 1u), tc::back(vecnExpected));
+	TEST_RANGE_EQUAL(vecn, vecnExpected);
+}
+
+UNITTESTDEF(partial_sum_materialized_other_operators) {
+	auto const vecn = make_test_data<int>(300000);
+	TEST_RANGE_EQUAL(tc::make_partial_sum(tc::par, vecn, -60000, tc::fn_assign_max()), tc::make_vector(tc::partial_sum_excluding_init(vecn, -60000, tc::fn_assign_max())));
+
+	// elements of a different type than the sum
+	TEST_RANGE_EQUAL(tc::make_partial_sum(tc::par, vecn, 0ll), tc::make_vector(tc::partial_sum_excluding_init(vecn, 0ll, tc::fn_assign_plus())));
+
+	// ranges without random access are scanned sequentially
+	auto const rngnOdd = tc::filter(vecn, [](int const n) noexcept { return 0 != n % 2; });
+	TEST_RANGE_EQUAL(tc::make_partial_sum(tc::par, rngnOdd, 0ll), tc::make_vector(tc::partial_sum_excluding_init(rngnOdd, 0ll, tc::fn_assign_plus())));
+	auto vecnInplace = vecn;
+	tc::vector<bool> vecbOdd;
+	for( int const n : vecn ) tc::cont_emplace_back(vecbOdd, 0 != n % 2);
+	auto const nSum = tc::partial_sum_inplace(tc::par, tc::filter(vecnInplace, [&](int const& n) noexcept { return tc::at(vecbOdd, &n - tc::ptr_begin(vecnInplace)); }), 0);
+	int nExpected = 0;
+	for( std::size_t i = 0; i < tc::size(vecn); ++i ) {
+		if( tc::at(vecbOdd, i) ) {
+			nExpected += tc::at(vecn, i);
+			_ASSERTEQUAL(tc::at(vecnInplace, i), nExpected);
+		} else {
+			_ASSERTEQUAL(tc::at(vecnInplace, i), tc::at(vecn, i));
+		}
+	}
+	_ASSERTEQUAL(nSum, nExpected);
+}
@@ -0,0 +1,150 @@
+// think-cell public library
+//
+// Copyright (C) 2016-2023 think-cell Software GmbH
+//
+// Distributed under the Boost Software License, Version 1.0.
+// See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt
+
+#pragma once
+
+#include "../base/assert_defs.h"
+#include "../base/casts.h"
+#include "../base/invoke.h"
+#include "../base/tc_move.h"
+#include "../base/trivial_functors.h"
+#include "../range/meta.h"
+
+#include "compare.h"
+#include "size.h"
+
+#include <algorithm>
+#include <array>
+#include <climits>
+#include <memory>
+
+namespace tc {
+	namespace radix_sort_detail {
+		template<typename Key>
+		concept radix_key = tc::actual_integer<Key> || (tc::enum_type<Key> && tc::actual_integer<std::underlying_type_t<Key>>);
+
+		// Maps key to an unsigned integer of the same size and the same order.
+		template<radix_key Key>
+		constexpr auto to_unsigned_key(Key const key) noexcept {
+			if constexpr( tc::enum_type<Key> ) {
+				return radix_sort_detail::to_unsigned_key(tc::to_underlying(key));
+			} else {
+				using Unsigned = std::make_unsigned_t<Key>;
+				if constexpr( std::is_signed<Key>::value ) {
+					return static_cast<Unsigned>(static_cast<Unsigned>(key) ^ (Unsigned(1) << (sizeof(Unsigned) * CHAR_BIT - 1)));
+				} else {
+					return static_cast<Unsigned>(key);
+				}
+			}
+		}
+
+		// Below this size, the histogram passes cost more than comparison sort.
+		inline constexpr std::size_t c_nMinRadixSortSize = 256;
+
+		template<typename Rng, typename Proj>
+		using key_t = tc::decay_t<decltype(tc::invoke(std::declval<Proj const&>(), std::declval<tc::range_value_t<Rng> const&>()))>;
+
+		template<typename Rng, typename Proj>
+		concept sortable =
+			tc::random_access_range<Rng> &&
+			radix_key<key_t<Rng, Proj>> &&
+			std::is_default_constructible<tc::range_value_t<Rng>>::value &&
+			std::is_nothrow_move_assignable<tc::range_value_t<Rng>>::value;
+
+		namespace no_adl {
+			// Extracts the key projection from orders that compare integral keys with tc::fn_less.
+			template<typename Less>
+			struct key_projection final {};
+
+			template<>
+			struct key_projection<tc::fn_less> final {
+				static constexpr tc::identity get(tc::fn_less const&) noexcept {
+					return {};
+				}
+			};
+
+			template<typename Func, typename Transform> requires std::is_same<tc::decay_t<Func>, tc::fn_less>::value
+			struct key_projection<tc::no_adl::projected_impl<Func, Transform>> final {
+				static constexpr auto const& get(tc::no_adl::projected_impl<Func, Transform> const& less) noexcept {
+					return less.m_transform;
+				}
+			};
+		}
+
+		template<typename Less>
+		constexpr auto key_projection(Less const& less) return_decltype_noexcept(
+			no_adl::key_projection<tc::decay_t<Less>>::get(less)
+		)
+
+		// An enum with an overloaded operator< or operator<=> may be ordered differently than its underlying values.
+		template<typename Key>
+		concept builtin_less = !tc::enum_type<Key> || (
+			!requires(Key const& lhs, Key const& rhs) { operator<(lhs, rhs); } &&
+			!requires(Key const& lhs, Key const& rhs) { operator<=>(lhs, rhs); }
+		);
+
+		template<typename Rng, typename Less>
+		concept sortable_by_less = requires(Less const& less) { radix_sort_detail::key_projection(less); } &&
+			sortable<Rng, decltype(radix_sort_detail::key_projection(std::declval<Less const&>()))> &&
+			builtin_less<key_t<Rng, decltype(radix_sort_detail::key_projection(std::declval<Less const&>()))>>;
+
+		template<typename ItSrc, typename ItDst, typename Proj>
+		void scatter(ItSrc itSrc, ItSrc const itSrcEnd, ItDst const itDst, Proj const& proj, int const nShift, std::array<std::size_t, 256> anOffset) noexcept {
+			for( ; itSrc != itSrcEnd; ++itSrc ) {
+				auto const nBucket = (radix_sort_detail::to_unsigned_key(tc::invoke(proj, tc::as_const(*itSrc))) >> nShift) & 0xff;
+				*(itDst + anOffset[nBucket]++) = tc_move_always(*itSrc);
+			}
+		}
+	}
+
+	// LSD radix sort by an integral or enum key, using a scratch buffer of the size of the range.
+	// Elements with equal keys keep their relative order, so this is a stable sort.
+	template<typename Rng, typename Proj = tc::identity> requires radix_sort_detail::sortable<Rng, Proj>
+	void radix_sort_inplace(Rng&& rng, Proj const& proj = Proj()) noexcept {
+		using Key = decltype(radix_sort_detail::to_unsigned_key(std::declval<radix_sort_detail::key_t<Rng, Proj>>()));
+		constexpr std::size_t c_nDigits = sizeof(Key);
+
+		auto const itBegin = tc::begin(rng);
+		auto const itEnd = tc::end(rng);
+		auto const n = tc::explicit_cast<std::size_t>(itEnd - itBegin);
+		if( n < 2 ) return;
+
+		// Compute the histograms of all digits in a single pass.
+		std::array<std::array<std::size_t, 256>, c_nDigits> aanCount{};
+		for( auto it = itBegin; it != itEnd; ++it ) {
+			auto const key = radix_sort_detail::to_unsigned_key(tc::invoke(proj, tc::as_const(*it)));
+			for( std::size_t nDigit = 0; nDigit < c_nDigits; ++nDigit ) {
+				++aanCount[nDigit][(key >> (nDigit * CHAR_BIT)) & 0xff];
+			}
+		}
+
+		auto const pvalScratch = std::make_unique_for_overwrite<tc::range_value_t<Rng>[]>(n); // MAYTHROW
+		bool bInScratch = false;
+		for( std::size_t nDigit = 0; nDigit < c_nDigits; ++nDigit ) {
+			auto const& anCount = aanCount[nDigit];
+			if( std::any_of(anCount.begin(), anCount.end(), [&](std::size_t const nCount) noexcept { return n == nCount; }) ) {
+				continue; // all elements have the same digit, the pass would not change the order
+			}
+			std::array<std::size_t, 256> anOffset;
+			std::size_t nSum = 0;
+			for( std::size_t nBucket = 0; nBucket < 256; ++nBucket ) {
+				anOffset[nBucket] = nSum;
+				nSum += anCount[nBucket];
+			}
+			auto const nShift = tc::explicit_cast<int>(nDigit * CHAR_BIT);
+			if( bInScratch ) {
+				radix_sort_detail::scatter(pvalScratch.get(), pvalScratch.get() + n, itBegin, proj, nShift, anOffset);
+			} else {
+				radix_sort_detail::scatter(itBegin, itEnd, pvalScratch.get(), proj, nShift, anOffset);
+			}
+			bInScratch = !bInScratch;
+		}
+		if( bInScratch ) {
+			std::move(pvalScratch.get(), pvalScratch.get() + n, itBegin);
+		}
+	}
+}
@@ -0,0 +1,84 @@
+// think-cell public library
+//
+// Copyright (C) 2016-2023 think-cell Software GmbH
+//
+// Distributed under the Boost Software License, Version 1.0.
+// See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt
+
+#include "../base/assert_defs.h"
+#include "../unittest.h"
+#include "../container/insert.h"
+#include "algorithm.h"
+
+#include <random>
+
+namespace {
+	enum class ERadixTest : signed char { a = -100, b = -1, c = 0, d = 1, e = 100 };
+
+	// ordered by descending underlying value
+	enum class EReversed : int { a = 2, b = 1, c = 0 };
+	[[maybe_unused]] bool operator<(EReversed const lhs, EReversed const rhs) noexcept {
+		return tc::to_underlying(rhs) < tc::to_underlying(lhs);
+	}
+
+	template<typename T>
+	void test_radix_sort(std::mt19937& rnd) noexcept {
+		for( std::size_t n : {0, 1, 2, 100, 1000, 10000} ) {
+			tc::vector<T> vec;
+			// std::uniform_int_distribution is not defined for char types
+			std::uniform_int_distribution<std::conditional_t<sizeof(T) < sizeof(int), int, T>> dist(std::numeric_limits<T>::lowest(), std::numeric_limits<T>::max());
+			for( std::size_t i = 0; i < n; ++i ) tc::cont_emplace_back(vec, static_cast<T>(dist(rnd)));
+			auto vecExpected = vec;
+			std::sort(tc::begin(vecExpected), tc::end(vecExpected));
+			auto vecRadix = vec;
+			tc::radix_sort_inplace(vecRadix);
+			_ASSERT(tc::equal(vecExpected, vecRadix));
+			tc::sort_inplace(vec);
+			_ASSERT(tc::equal(vecExpected, vec));
+		}
+	}
+}
+
+UNITTESTDEF( radix_sort ) {
+	std::mt19937 rnd(42);
+	test_radix_sort<int>(rnd);
+	test_radix_sort<unsigned int>(rnd);
+	test_radix_sort<short>(rnd);
+	test_radix_sort<long long>(rnd);
+	test_radix_sort<unsigned long long>(rnd);
+
+	static_assert(tc::radix_sort_detail::sortable_by_less<tc::vector<int>&, tc::fn_less>);
+	static_assert(tc::radix_sort_detail::sortable_by_less<tc::vector<ERadixTest>&, tc::fn_less>);
+	static_assert(!tc::radix_sort_detail::sortable_by_less<tc::vector<int>&, tc::fn_greater>);
+	static_assert(!tc::radix_sort_detail::sortable_by_less<tc::vector<double>&, tc::fn_less>);
+	static_assert(!tc::radix_sort_detail::sortable_by_less<tc::vector<EReversed>&, tc::fn_less>);
+
+	{
+		// user-defined operator< is respected
+		tc::vector<EReversed> vece;
+		for( int i = 0; i < 1000; ++i ) tc::cont_emplace_back(vece, static_cast<EReversed>(i % 3));
+		tc::sort_inplace(vece);
+		_ASSERTEQUAL(tc::front(vece), EReversed::a);
+		_ASSERTEQUAL(tc::back(vece), EReversed::c);
+		tc::stable_sort_inplace(vece);
+		_ASSERTEQUAL(tc::front(vece), EReversed::a);
+	}
+
+	{
+		tc::vector<ERadixTest> vece;
+		for( int i = 0; i < 1000; ++i ) tc::cont_emplace_back(vece, tc::at(tc::make_array(tc::aggregate_tag, ERadixTest::e, ERadixTest::a, ERadixTest::d, ERadixTest::b, ERadixTest::c), i % 5));
+		tc::sort_inplace(vece);
+		_ASSERT(tc::is_sorted(vece));
+		_ASSERTEQUAL(tc::front(vece), ERadixTest::a);
+		_ASSERTEQUAL(tc::back(vece), ERadixTest::e);
+	}
+	{
+		// projected keys, radix sort is stable
+		tc::vector<std::pair<int, int>> vecpairn;
+		for( int i = 0; i < 1000; ++i ) tc::cont_emplace_back(vecpairn, (i * 7919) % 13 - 6, i);
+		auto vecpairnExpected = vecpairn;
+		std::stable_sort(tc::begin(vecpairnExpected), tc::end(vecpairnExpected), [](auto const& lhs, auto const& rhs) noexcept { return lhs.first < rhs.first; });
+		tc::stable_sort_inplace(vecpairn, tc::projected(tc::fn_less(), tc_member(.first)));
+		_ASSERT(tc::equal(vecpairnExpected, vecpairn));
+	}
+}
@@ -0,0 +1,275 @@
+// think-cell public library
+//
+// Copyright (C) 2016-2023 think-cell Software GmbH
+//
+// Distributed under the Boost Software License, Version 1.0.
+// See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt
+
+#pragma once
+
+#include "../base/assert_defs.h"
+#include "../base/explicit_cast.h"
+#include "../range/meta.h"
+#include "../range/subrange.h"
+#include "../container/container.h"
+#include "append.h"
+#include "minmax.h"
+#include "simd.h"
+
+#include <array>
+#include <concepts>
+#include <cstring>
+#include <iterator>
+#include <limits>
+#include <tuple>
+
+// Substring search in O(n+m) time with the Two-Way algorithm of Crochemore and Perrin, like glibc's memmem. For bytes, a
+// Boyer-Moore-Horspool shift table lets the search skip parts of the haystack, and short needles are found with a vectorized
+// filter on their first and last byte.
+namespace tc {
+	namespace search_detail {
+		inline constexpr std::size_t c_nNotFound = std::numeric_limits<std::size_t>::max();
+
+		template<typename T>
+		concept byte_comparable = tc::simd_detail::bitwise_comparable<T> && 1 == sizeof(T);
+
+#ifdef TC_SIMD_X64
+		// Short needles: compare the first and the last byte of the needle at 16 or 32 positions at once and verify the candidates.
+#define TC_SEARCH_KERNEL(target, width, load, broadcast) \
+		template<typename T> \
+		target std::size_t find_short_##width(T const* const pHay, std::size_t const nHay, T const* const pNeedle, std::size_t const nNeedle, std::size_t j) noexcept { \
+			_ASSERTDEBUG( 2 <= nNeedle ); \
+			constexpr std::size_t c_nLanes = width / 8; \
+			auto const vectFirst = broadcast(pNeedle[0]); \
+			auto const vectLast = broadcast(pNeedle[nNeedle - 1]); \
+			for( ; j + nNeedle - 1 + c_nLanes <= nHay; j += c_nLanes ) { \
+				auto nMask = tc::simd_detail::equal_mask<1>(load(pHay + j), vectFirst) & tc::simd_detail::equal_mask<1>(load(pHay + j + nNeedle - 1), vectLast); \
+				for( ; 0 != nMask; nMask &= nMask - 1 ) { \
+					auto const i = j + tc::index_of_least_significant_bit(nMask); \
+					if( 0 == std::memcmp(pHay + i + 1, pNeedle + 1, nNeedle - 2) ) return i; \
+				} \
+			} \
+			for( ; j + nNeedle <= nHay; ++j ) { \
+				if( 0 == std::memcmp(pHay + j, pNeedle, nNeedle) ) return j; \
+			} \
+			return c_nNotFound; \
+		}
+
+		TC_SEARCH_KERNEL(, 128, tc::simd_detail::load_sse2, tc::simd_detail::broadcast_sse2)
+		TC_SEARCH_KERNEL(TC_TARGET_AVX2, 256, tc::simd_detail::load_avx2, tc::simd_detail::broadcast_avx2)
+#undef TC_SEARCH_KERNEL
+#endif
+	}
+
+	namespace no_adl {
+		// Preprocessed needle, which can be searched for in many haystacks.
+		template<std::totally_ordered T>
+		struct [[nodiscard]] searcher final {
+		private:
+			static constexpr bool c_bBytes = search_detail::byte_comparable<T>;
+			static constexpr std::size_t c_nMaxShortNeedle = 16;
+
+			tc::vector<T> m_vecNeedle;
+			std::size_t m_nSuffix; // start of the right half of the critical factorization
+			std::size_t m_nPeriod;
+			bool m_bPeriodic; // the left half is a suffix of the first period of the right half
+			std::array<std::size_t, c_bBytes ? 256 : 0> m_anShift; // Horspool shift for the last byte of the window
+
+			static std::size_t byte_index(T const& t) noexcept requires c_bBytes {
+				return tc::simd_detail::as_uint(t);
+			}
+
+			// Returns the start of the maximal suffix of the needle with respect to < (bReverse = false) or > (bReverse = true) and its period.
+			std::pair<std::size_t, std::size_t> maximal_suffix(bool const bReverse) const& noexcept {
+				auto const n = tc::size_raw(m_vecNeedle);
+				std::ptrdiff_t nMaxSuffix = -1;
+				std::size_t j = 0;
+				std::size_t k = 1;
+				std::size_t p = 1;
+				while( j + k < n ) {
+					auto const& a = tc::at(m_vecNeedle, j + k);
+					auto const& b = tc::at(m_vecNeedle, tc::explicit_cast<std::size_t>(nMaxSuffix + tc::explicit_cast<std::ptrdiff_t>(k)));
+					if( bReverse ? b < a : a < b ) {
+						j += k;
+						k = 1;
+						p = tc::explicit_cast<std::size_t>(tc::explicit_cast<std::ptrdiff_t>(j) - nMaxSuffix);
+					} else if( a == b ) {
+						if( k != p ) {
+							++k;
+						} else {
+							j += p;
+							k = 1;
+						}
+					} else {
+						nMaxSuffix = tc::explicit_cast<std::ptrdiff_t>(j);
+						j = j + 1;
+						k = 1;
+						p = 1;
+					}
+				}
+				return {tc::explicit_cast<std::size_t>(nMaxSuffix + 1), p};
+			}
+
+		public:
+			template<typename Rng>
+			explicit searcher(Rng&& rngNeedle) MAYTHROW
+				: m_vecNeedle(tc::explicit_cast<tc::vector<T>>(std::forward<Rng>(rngNeedle)))
+			{
+				auto const n = tc::size_raw(m_vecNeedle);
+				if( n < 3 ) {
+					m_nSuffix = n - (0 < n ? 1 : 0);
+					m_nPeriod = 1;
+				} else {
+					auto const pairnForward = maximal_suffix(/*bReverse*/false);
+					auto const pairnReverse = maximal_suffix(/*bReverse*/true);
+					std::tie(m_nSuffix, m_nPeriod) = pairnReverse.first < pairnForward.first ? pairnForward : pairnReverse;
+				}
+				m_bPeriodic = m_nSuffix + m_nPeriod <= n && std::equal(tc::begin(m_vecNeedle), tc::begin(m_vecNeedle) + m_nSuffix, tc::begin(m_vecNeedle) + m_nPeriod);
+				if( !m_bPeriodic ) {
+					// The needle is not periodic, shifting by this much cannot skip an occurrence.
+					m_nPeriod = tc::max(m_nSuffix, n - m_nSuffix) + 1;
+				}
+				if constexpr( c_bBytes ) {
+					m_anShift.fill(n);
+					for( std::size_t i = 0; i < n; ++i ) {
+						m_anShift[byte_index(tc::at(m_vecNeedle, i))] = n - i - 1;
+					}
+				}
+			}
+
+			auto const& needle() const& noexcept {
+				return m_vecNeedle;
+			}
+
+			// Start of the first occurrence of the needle in [itHay, itHay + nHay), starting at the offset j, or c_nNotFound.
+			template<std::random_access_iterator It>
+			std::size_t find(It const itHay, std::size_t const nHay, std::size_t j) const& noexcept {
+				auto const n = tc::size_raw(m_vecNeedle);
+				if( nHay < n ) return search_detail::c_nNotFound;
+				if( 0 == n ) return j;
+				auto const Hay = [&](std::size_t const i) noexcept -> decltype(auto) { return *(itHay + tc::explicit_cast<std::iter_difference_t<It>>(i)); };
+				if constexpr( c_bBytes && std::contiguous_iterator<It> && std::is_same<std::remove_cv_t<std::iter_value_t<It>>, T>::value ) {
+					T const* const pHay = std::to_address(itHay);
+					if( 1 == n ) {
+						if( auto const p = tc::simd_detail::find_first_equal(pHay + j, pHay + nHay, tc::front(m_vecNeedle)) ) {
+							return tc::explicit_cast<std::size_t>(p - pHay);
+						} else {
+							return search_detail::c_nNotFound;
+						}
+					}
+#ifdef TC_SIMD_X64
+					if( n <= c_nMaxShortNeedle ) {
+						return tc::simd_detail::has_avx2()
+							? search_detail::find_short_256(pHay, nHay, tc::ptr_begin(m_vecNeedle), n, j)
+							: search_detail::find_short_128(pHay, nHay, tc::ptr_begin(m_vecNeedle), n, j);
+					}
+#endif
+				}
+
+				// Two-Way: match the right half left to right, then the left half right to left.
+				// nMemory is the length of the prefix known to match after a shift by the period of a periodic needle.
+				std::size_t nMemory = 0;
+				while( j <= nHay - n ) {
+					std::size_t nMatchRight = n;
+					if constexpr( c_bBytes ) {
+						// Horspool: the window can only match if its last element matches.
+						if( auto nShift = m_anShift[byte_index(Hay(j + n - 1))]; 0 < nShift ) {
+							if( 0 < nMemory && nShift < m_nPeriod ) {
+								nShift = n - m_nPeriod; // there can be no match before the element that did not fit the period
+							}
+							nMemory = 0;
+							j += nShift;
+							continue;
+						}
+						nMatchRight = n - 1;
+					}
+					std::size_t i = tc::max(m_nSuffix, nMemory);
+					while( i < nMatchRight && tc::at(m_vecNeedle, i) == Hay(i + j) ) ++i;
+					if( nMatchRight <= i ) {
+						auto const nLeftEnd = m_bPeriodic ? nMemory : 0;
+						i = m_nSuffix;
+						while( nLeftEnd < i && tc::at(m_vecNeedle, i - 1) == Hay(i - 1 + j) ) --i;
+						if( i <= nLeftEnd ) return j;
+						j += m_nPeriod;
+						nMemory = m_bPeriodic ? n - m_nPeriod : 0;
+					} else {
+						j += i - m_nSuffix + 1;
+						nMemory = 0;
+					}
+				}
+				return search_detail::c_nNotFound;
+			}
+		};
+
+		template<typename Rng>
+		searcher(Rng&&) -> searcher<tc::range_value_t<Rng>>;
+	}
+	using no_adl::searcher;
+
+	namespace search_detail {
+		template<typename Rng>
+		concept random_access_haystack = tc::random_access_range<Rng> && tc::common_range<Rng>;
+	}
+
+	// First occurrence of the needle of searcher in rng, returned as a view like tc::search_first, e.g., with tc::return_view_or_none,
+	// tc::return_bool or tc::return_take_before_or_none.
+	template<typename RangeReturn, search_detail::random_access_haystack Rng, typename T>
+	[[nodiscard]] decltype(auto) search(Rng&& rng, tc::searcher<T> const& searcher) noexcept {
+		auto const itBegin = tc::begin(rng);
+		auto const nHay = tc::explicit_cast<std::size_t>(tc::end(rng) - itBegin);
+		if( auto const j = searcher.find(itBegin, nHay, 0); search_detail::c_nNotFound != j ) {
+			auto const itMatch = itBegin + tc::explicit_cast<std::iter_difference_t<decltype(itBegin)>>(j);
+			return RangeReturn::pack_view(std::forward<Rng>(rng), itMatch, itMatch + tc::explicit_cast<std::iter_difference_t<decltype(itBegin)>>(tc::size_raw(searcher.needle())));
+		} else {
+			return RangeReturn::pack_no_element(std::forward<Rng>(rng));
+		}
+	}
+
+	template<typename RangeReturn, search_detail::random_access_haystack Rng, typename RngNeedle> requires (!tc::instance<std::remove_cvref_t<RngNeedle>, tc::searcher>)
+	[[nodiscard]] decltype(auto) search(Rng&& rng, RngNeedle&& rngNeedle) MAYTHROW {
+		return tc::search<RangeReturn>(std::forward<Rng>(rng), tc::searcher<tc::range_value_t<Rng>>(std::forward<RngNeedle>(rngNeedle))); // MAYTHROW
+	}
+
+	namespace no_adl {
+		template<typename Rng, typename T>
+		struct [[nodiscard]] search_all_adaptor final : tc::range_adaptor_base_range<Rng> {
+			template<typename RngRef>
+			search_all_adaptor(RngRef&& rng, tc::searcher<T> const& searcher) noexcept
+				: tc::range_adaptor_base_range<Rng>(aggregate_tag, std::forward<RngRef>(rng))
+				, m_searcher(searcher)
+			{}
+
+			template<typename Sink>
+			auto operator()(Sink const& sink) const& MAYTHROW {
+				auto const& rng = this->base_range();
+				auto const itBegin = tc::begin(rng);
+				auto const nHay = tc::explicit_cast<std::size_t>(tc::end(rng) - itBegin);
+				auto const nNeedle = tc::explicit_cast<std::iter_difference_t<decltype(itBegin)>>(tc::size_raw(m_searcher.needle()));
+				std::size_t j = 0;
+				for(;;) {
+					j = m_searcher.find(itBegin, nHay, j);
+					if( search_detail::c_nNotFound == j ) return tc::constant<tc::continue_>();
+					auto const itMatch = itBegin + tc::explicit_cast<std::iter_difference_t<decltype(itBegin)>>(j);
+					tc_yield(sink, tc::make_iterator_range(itMatch, itMatch + nNeedle));
+					j += tc::max(tc::explicit_cast<std::size_t>(nNeedle), std::size_t(1)); // an empty needle is found between all elements
+					if( nHay < j ) return tc::constant<tc::continue_>();
+				}
+			}
+
+		private:
+			tc::searcher<T> const& m_searcher;
+		};
+	}
+
+	// All non-overlapping occurrences of the needle of searcher in rng, from left to right, as subranges of rng.
+	// The searcher must outlive the returned range.
+	template<search_detail::random_access_haystack Rng, typename T>
+	auto search_all(Rng&& rng, tc::searcher<T> const& searcher) return_ctor_noexcept(
+		TC_FWD(no_adl::search_all_adaptor<Rng, T>),
+		(std::forward<Rng>(rng), searcher)
+	)
+
+	// The returned range would refer to the destroyed searcher.
+	template<typename Rng, typename T>
+	void search_all(Rng&& rng, tc::searcher<T>&& searcher) = delete;
+}
@@ -0,0 +1,104 @@
+// think-cell public library
+//
+// Copyright (C) 2016-2023 think-cell Software GmbH
+//
+// Distributed under the Boost Software License, Version 1.0.
+// See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt
+
+#include "../base/assert_defs.h"
+#include "../unittest.h"
+#include "search.h"
+#include "../range/repeat_n.h"
+
+#include <algorithm>
+#include <deque>
+#include <random>
+
+namespace {
+	template<typename Hay, typename Needle>
+	std::size_t naive_search(Hay const& hay, Needle const& needle, std::size_t const j) noexcept {
+		auto const it = std::search(tc::begin(hay) + tc::explicit_cast<std::ptrdiff_t>(j), tc::end(hay), tc::begin(needle), tc::end(needle));
+		return tc::end(hay) == it && !tc::empty(needle) ? tc::search_detail::c_nNotFound : tc::explicit_cast<std::size_t>(it - tc::begin(hay));
+	}
+}
+
+UNITTESTDEF(search) {
+	auto const str = tc::make_str<char>("abracadabra");
+	_ASSERT(tc::equal(*tc::search<tc::return_view_or_none>(str, "cad"), "cad"));
+	_ASSERTEQUAL(tc::ptr_begin(*tc::search<tc::return_view_or_none>(str, "abra")), tc::ptr_begin(str));
+	_ASSERT(!tc::search<tc::return_view_or_none>(str, "abrax"));
+	_ASSERT(!tc::search<tc::return_bool>(str, "bb"));
+	_ASSERT(tc::search<tc::return_bool>(str, ""));
+	_ASSERT(!tc::search<tc::return_bool>(tc::make_str<char>(""), "a"));
+	_ASSERT(tc::equal(tc::search<tc::return_take_before_or_empty>(str, "cad"), "abra"));
+	_ASSERT(tc::equal(tc::search<tc::return_drop_after_or_empty>(str, "cad"), "abra"));
+	_ASSERTEQUAL(tc::search<tc::return_border_before_or_end>(str, "dab"), tc::begin(str) + 6);
+
+	// long needles, periodic and not
+	auto const strHay = tc::make_str<char>(tc::repeat_n(100, 'a'), "b", tc::repeat_n(100, 'a'), "xyz0123456789abcdefghij");
+	_ASSERTEQUAL(tc::search<tc::return_border_before_or_end>(strHay, tc::make_str<char>(tc::repeat_n(50, 'a'), "b")), tc::begin(strHay) + 50);
+	_ASSERTEQUAL(tc::search<tc::return_border_before_or_end>(strHay, tc::make_str<char>("b", tc::repeat_n(100, 'a'))), tc::begin(strHay) + 100);
+	_ASSERTEQUAL(tc::search<tc::return_border_before_or_end>(strHay, "xyz0123456789abcdefghij"), tc::begin(strHay) + 201);
+	_ASSERT(!tc::search<tc::return_bool>(strHay, tc::make_str<char>(tc::repeat_n(101, 'a'))));
+
+	// other element types and non-contiguous haystacks
+	tc::vector<int> const vecn{3, 1, 4, 1, 5, 9, 2, 6, 5, 3, 5};
+	_ASSERTEQUAL(tc::search<tc::return_border_before_or_end>(vecn, tc::vector<int>{5, 3, 5}), tc::begin(vecn) + 8);
+	std::deque<char> const dequech(tc::begin(strHay), tc::end(strHay));
+	_ASSERTEQUAL(tc::search<tc::return_border_before_or_end>(dequech, "abcdefghij"), tc::begin(dequech) + 214);
+}
+
+namespace {
+	template<typename Searcher>
+	concept search_all_accepts = requires(tc::string<char> const& str, Searcher&& searcher) { tc::search_all(str, std::forward<Searcher>(searcher)); };
+	static_assert( search_all_accepts<tc::searcher<char> const&> );
+	static_assert( !search_all_accepts<tc::searcher<char>> ); // the searcher must outlive the returned range
+}
+
+UNITTESTDEF(search_all) {
+	// a searcher is reused across haystacks
+	tc::searcher const searcher("aba");
+	auto const str = tc::make_str<char>("ababa_aba");
+	tc::vector<std::ptrdiff_t> vecn;
+	tc::for_each(tc::search_all(str, searcher), [&](auto const& rngch) noexcept {
+		_ASSERT(tc::equal(rngch, "aba"));
+		tc::cont_emplace_back(vecn, tc::ptr_begin(rngch) - tc::ptr_begin(str));
+	});
+	TEST_RANGE_EQUAL(vecn, (tc::vector<std::ptrdiff_t>{0, 6})); // matches do not overlap
+	_ASSERT(tc::search<tc::return_bool>(tc::make_str<char>("xxabaxx"), searcher));
+	_ASSERT(!tc::search<tc::return_bool>(tc::make_str<char>("xxabxx"), searcher));
+
+	int nEmpty = 0;
+	tc::searcher const searcherEmpty(tc::make_str<char>(""));
+	tc::for_each(tc::search_all(tc::make_str<char>("ab"), searcherEmpty), [&](auto const& rngch) noexcept {
+		_ASSERT(tc::empty(rngch));
+		++nEmpty;
+	});
+	_ASSERTEQUAL(nEmpty, 3);
+}
+
+UNITTESTDEF(search_random) {
+	std::mt19937 gen(42);
+	auto const Random = [&](std::size_t const n, char const chMax) noexcept {
+		tc::string<char> str;
+		for( std::size_t i = 0; i < n; ++i ) {
+			tc::cont_emplace_back(str, static_cast<char>('a' + std::uniform_int_distribution<int>(0, chMax - 'a')(gen)));
+		}
+		return str;
+	};
+	for( int i = 0; i < 2000; ++i ) {
+		// small alphabets produce periodic needles and many partial matches
+		auto const chMax = "bcz"[i % 3];
+		auto const strHay = Random(std::uniform_int_distribution<std::size_t>(0, 200)(gen), chMax);
+		auto const strNeedle = Random(std::uniform_int_distribution<std::size_t>(0, 40)(gen), chMax);
+		tc::searcher const searcher(strNeedle);
+		for( std::size_t j = 0; j <= tc::size_raw(strHay); j += 17 ) {
+			_ASSERTEQUAL(searcher.find(tc::begin(strHay), tc::size_raw(strHay), j), naive_search(strHay, strNeedle, j));
+		}
+		std::deque<char> const dequech(tc::begin(strHay), tc::end(strHay));
+		_ASSERTEQUAL(searcher.find(tc::begin(dequech), tc::size_raw(dequech), 0), naive_search(strHay, strNeedle, 0));
+		tc::vector<int> const vecnHay(tc::begin(strHay), tc::end(strHay));
+		tc::vector<int> const vecnNeedle(tc::begin(strNeedle), tc::end(strNeedle));
+		_ASSERTEQUAL(tc::searcher(vecnNeedle).find(tc::begin(vecnHay), tc::size_raw(vecnHay), 0), naive_search(strHay, strNeedle, 0));
+	}
+}
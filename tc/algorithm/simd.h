@@ -0,0 +1,287 @@
+// think-cell public library
+//
+// Copyright (C) 2016-2023 think-cell Software GmbH
+//
+// Distributed under the Boost Software License, Version 1.0.
+// See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt
+
+#pragma once
+
+#include "../base/assert_defs.h"
+#include "../base/bit_cast.h"
+#include "../base/bitfield.h"
+#include "../base/explicit_cast.h"
+#include "../range/meta.h"
+
+#include <cstdint>
+#include <type_traits>
+
+#if defined(_M_X64) || defined(__x86_64__)
+	#define TC_SIMD_X64
+	#include <immintrin.h>
+	#ifdef _MSC_VER
+		#include <intrin.h>
+		#define TC_TARGET_AVX2
+	#else
+		#define TC_TARGET_AVX2 __attribute__((target("avx2")))
+	#endif
+#endif
+
+// Vectorized kernels on contiguous memory. On x64, SSE2 is always available and AVX2 is dispatched at runtime.
+// On other platforms, the kernels fall back to scalar loops.
+namespace tc {
+	namespace simd_detail {
+		// Types whose operator== compares the object representation. An enum with an overloaded operator== or operator<=>
+		// may consider different values equal.
+		template<typename T>
+		concept bitwise_comparable =
+			(std::is_integral<T>::value || std::is_pointer<T>::value || (
+				std::is_enum<T>::value &&
+				!requires(T const& lhs, T const& rhs) { operator==(lhs, rhs); } &&
+				!requires(T const& lhs, T const& rhs) { operator<=>(lhs, rhs); }
+			)) &&
+			(1 == sizeof(T) || 2 == sizeof(T) || 4 == sizeof(T) || 8 == sizeof(T));
+
+		template<std::size_t N>
+		using uint_t = std::conditional_t<1 == N, std::uint8_t, std::conditional_t<2 == N, std::uint16_t, std::conditional_t<4 == N, std::uint32_t, std::uint64_t>>>;
+
+		template<typename T>
+		auto as_uint(T const t) noexcept {
+			return tc::bit_cast<uint_t<sizeof(T)>>(t);
+		}
+
+#ifdef TC_SIMD_X64
+		inline bool has_avx2() noexcept {
+			static bool const s_bAvx2 = []() noexcept {
+#ifdef _MSC_VER
+				int anCpuInfo[4];
+				__cpuid(anCpuInfo, 1);
+				bool const bOsxsave = 0 != (anCpuInfo[2] & (1 << 27));
+				bool const bAvx = 0 != (anCpuInfo[2] & (1 << 28));
+				if( !bOsxsave || !bAvx || 6 != (_xgetbv(0) & 6) ) return false; // OS must save the ymm registers
+				__cpuidex(anCpuInfo, 7, 0);
+				return 0 != (anCpuInfo[1] & (1 << 5));
+#else
+				return 0 != __builtin_cpu_supports("avx2");
+#endif
+			}();
+			return s_bAvx2;
+		}
+
+		// One bit per byte, set for bytes of elements of size N that compare equal.
+		template<std::size_t N>
+		unsigned int equal_mask(__m128i const lhs, __m128i const rhs) noexcept {
+			if constexpr( 1 == N ) {
+				return static_cast<unsigned int>(_mm_movemask_epi8(_mm_cmpeq_epi8(lhs, rhs)));
+			} else if constexpr( 2 == N ) {
+				return static_cast<unsigned int>(_mm_movemask_epi8(_mm_cmpeq_epi16(lhs, rhs)));
+			} else if constexpr( 4 == N ) {
+				return static_cast<unsigned int>(_mm_movemask_epi8(_mm_cmpeq_epi32(lhs, rhs)));
+			} else {
+				static_assert( 8 == N );
+				__m128i const eq = _mm_cmpeq_epi32(lhs, rhs); // SSE2 has no 64-bit compare, combine the halves
+				return static_cast<unsigned int>(_mm_movemask_epi8(_mm_and_si128(eq, _mm_shuffle_epi32(eq, _MM_SHUFFLE(2, 3, 0, 1)))));
+			}
+		}
+
+		template<std::size_t N>
+		TC_TARGET_AVX2 unsigned int equal_mask(__m256i const lhs, __m256i const rhs) noexcept {
+			if constexpr( 1 == N ) {
+				return static_cast<unsigned int>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(lhs, rhs)));
+			} else if constexpr( 2 == N ) {
+				return static_cast<unsigned int>(_mm256_movemask_epi8(_mm256_cmpeq_epi16(lhs, rhs)));
+			} else if constexpr( 4 == N ) {
+				return static_cast<unsigned int>(_mm256_movemask_epi8(_mm256_cmpeq_epi32(lhs, rhs)));
+			} else {
+				static_assert( 8 == N );
+				return static_cast<unsigned int>(_mm256_movemask_epi8(_mm256_cmpeq_epi64(lhs, rhs)));
+			}
+		}
+
+		template<typename T>
+		__m128i broadcast_sse2(T const t) noexcept {
+			auto const u = simd_detail::as_uint(t);
+			if constexpr( 1 == sizeof(T) ) {
+				return _mm_set1_epi8(static_cast<char>(u));
+			} else if constexpr( 2 == sizeof(T) ) {
+				return _mm_set1_epi16(static_cast<short>(u));
+			} else if constexpr( 4 == sizeof(T) ) {
+				return _mm_set1_epi32(static_cast<int>(u));
+			} else {
+				return _mm_set1_epi64x(static_cast<long long>(u));
+			}
+		}
+
+		template<typename T>
+		TC_TARGET_AVX2 __m256i broadcast_avx2(T const t) noexcept {
+			auto const u = simd_detail::as_uint(t);
+			if constexpr( 1 == sizeof(T) ) {
+				return _mm256_set1_epi8(static_cast<char>(u));
+			} else if constexpr( 2 == sizeof(T) ) {
+				return _mm256_set1_epi16(static_cast<short>(u));
+			} else if constexpr( 4 == sizeof(T) ) {
+				return _mm256_set1_epi32(static_cast<int>(u));
+			} else {
+				return _mm256_set1_epi64x(static_cast<long long>(u));
+			}
+		}
+
+		inline __m128i load_sse2(void const* pv) noexcept {
+			return _mm_loadu_si128(static_cast<__m128i const*>(pv));
+		}
+
+		TC_TARGET_AVX2 inline __m256i load_avx2(void const* pv) noexcept {
+			return _mm256_loadu_si256(static_cast<__m256i const*>(pv));
+		}
+
+		// Stamped out for both vector widths, because GCC and Clang only inline AVX2 intrinsics into functions with the AVX2 target attribute.
+#define TC_SIMD_KERNELS(target, width, load, broadcast) \
+		template<typename T> \
+		target T const* find_first_equal_##width(T const* p, T const* const pEnd, T const t) noexcept { \
+			constexpr std::size_t c_nLanes = width / 8 / sizeof(T); \
+			auto const vect = broadcast(t); \
+			for( ; c_nLanes <= tc::explicit_cast<std::size_t>(pEnd - p); p += c_nLanes ) { \
+				if( auto const nMask = equal_mask<sizeof(T)>(load(p), vect) ) { \
+					return p + tc::index_of_least_significant_bit(nMask) / sizeof(T); \
+				} \
+			} \
+			for( ; p != pEnd; ++p ) { \
+				if( *p == t ) return p; \
+			} \
+			return nullptr; \
+		} \
+		\
+		template<typename T> \
+		target T const* find_last_equal_##width(T const* const pBegin, T const* p, T const t) noexcept { \
+			constexpr std::size_t c_nLanes = width / 8 / sizeof(T); \
+			auto const vect = broadcast(t); \
+			for( ; c_nLanes <= tc::explicit_cast<std::size_t>(p - pBegin); ) { \
+				p -= c_nLanes; \
+				if( auto const nMask = equal_mask<sizeof(T)>(load(p), vect) ) { \
+					return p + tc::index_of_most_significant_bit(nMask) / sizeof(T); \
+				} \
+			} \
+			while( p != pBegin ) { \
+				--p; \
+				if( *p == t ) return p; \
+			} \
+			return nullptr; \
+		} \
+		\
+		template<typename T> \
+		target std::size_t mismatch_##width(T const* const pLhs, T const* const pRhs, std::size_t const n) noexcept { \
+			constexpr std::size_t c_nLanes = width / 8 / sizeof(T); \
+			constexpr unsigned int c_nMaskAll = 128 == width ? 0xffffu : 0xffffffffu; \
+			std::size_t i = 0; \
+			for( ; i + c_nLanes <= n; i += c_nLanes ) { \
+				if( auto const nMask = equal_mask<sizeof(T)>(load(pLhs + i), load(pRhs + i)); c_nMaskAll != nMask ) { \
+					return i + tc::index_of_least_significant_bit(~nMask) / sizeof(T); \
+				} \
+			} \
+			for( ; i < n && pLhs[i] == pRhs[i]; ++i ) {} \
+			return i; \
+		}
+
+		TC_SIMD_KERNELS(, 128, load_sse2, broadcast_sse2)
+		TC_SIMD_KERNELS(TC_TARGET_AVX2, 256, load_avx2, broadcast_avx2)
+#undef TC_SIMD_KERNELS
+#endif
+
+		// First element in [pBegin, pEnd) equal to t, or nullptr.
+		template<bitwise_comparable T>
+		T const* find_first_equal(T const* const pBegin, T const* const pEnd, T const t) noexcept {
+#ifdef TC_SIMD_X64
+			if( simd_detail::has_avx2() ) {
+				return simd_detail::find_first_equal_256(pBegin, pEnd, t);
+			} else {
+				return simd_detail::find_first_equal_128(pBegin, pEnd, t);
+			}
+#else
+			for( auto p = pBegin; p != pEnd; ++p ) {
+				if( *p == t ) return p;
+			}
+			return nullptr;
+#endif
+		}
+
+		// Last element in [pBegin, pEnd) equal to t, or nullptr.
+		template<bitwise_comparable T>
+		T const* find_last_equal(T const* const pBegin, T const* const pEnd, T const t) noexcept {
+#ifdef TC_SIMD_X64
+			if( simd_detail::has_avx2() ) {
+				return simd_detail::find_last_equal_256(pBegin, pEnd, t);
+			} else {
+				return simd_detail::find_last_equal_128(pBegin, pEnd, t);
+			}
+#else
+			for( auto p = pEnd; p != pBegin; ) {
+				--p;
+				if( *p == t ) return p;
+			}
+			return nullptr;
+#endif
+		}
+
+		// Index of the first element in which [pLhs, pLhs + n) and [pRhs, pRhs + n) differ, or n.
+		template<bitwise_comparable T>
+		std::size_t mismatch(T const* const pLhs, T const* const pRhs, std::size_t const n) noexcept {
+#ifdef TC_SIMD_X64
+			if( simd_detail::has_avx2() ) {
+				return simd_detail::mismatch_256(pLhs, pRhs, n);
+			} else {
+				return simd_detail::mismatch_128(pLhs, pRhs, n);
+			}
+#else
+			std::size_t i = 0;
+			for( ; i < n && pLhs[i] == pRhs[i]; ++i ) {}
+			return i;
+#endif
+		}
+
+		// Integers whose sums wrap around like the sums of their object representations.
+		template<typename T>
+		concept scannable_integer = std::is_integral<T>::value && !std::is_same<T, bool>::value && (4 == sizeof(T) || 8 == sizeof(T));
+
+		// pDst[i] = tAccu + pSrc[0] + ... + pSrc[i], wrapping around on overflow. pDst may be pSrc. Returns the last sum.
+		template<scannable_integer T>
+		T inclusive_scan_plus(T const* const pSrc, T* const pDst, std::size_t const n, T const tAccu) noexcept {
+			auto nAccu = simd_detail::as_uint(tAccu);
+			std::size_t i = 0;
+#ifdef TC_SIMD_X64
+			// Within a register, add the elements shifted by one, then by two positions, then the sum of all previous registers.
+			// AVX2 would need additional shuffles across its 128-bit lanes, which is not worth it for a memory-bound loop.
+			constexpr std::size_t c_nLanes = 16 / sizeof(T);
+			if( c_nLanes <= n ) {
+				auto vecAccu = simd_detail::broadcast_sse2(tAccu);
+				for( ; i + c_nLanes <= n; i += c_nLanes ) {
+					auto vec = simd_detail::load_sse2(pSrc + i);
+					if constexpr( 4 == sizeof(T) ) {
+						vec = _mm_add_epi32(vec, _mm_slli_si128(vec, 4));
+						vec = _mm_add_epi32(vec, _mm_slli_si128(vec, 8));
+						vec = _mm_add_epi32(vec, vecAccu);
+						vecAccu = _mm_shuffle_epi32(vec, _MM_SHUFFLE(3, 3, 3, 3));
+					} else {
+						vec = _mm_add_epi64(vec, _mm_slli_si128(vec, 8));
+						vec = _mm_add_epi64(vec, vecAccu);
+						vecAccu = _mm_shuffle_epi32(vec, _MM_SHUFFLE(3, 2, 3, 2));
+					}
+					_mm_storeu_si128(reinterpret_cast<__m128i*>(pDst + i), vec);
+				}
+				nAccu = simd_detail::as_uint(pDst[i - 1]);
+			}
+#endif
+			for( ; i < n; ++i ) {
+				nAccu += simd_detail::as_uint(pSrc[i]);
+				pDst[i] = tc::bit_cast<T>(nAccu);
+			}
+			return tc::bit_cast<T>(nAccu);
+		}
+
+		template<typename LRng, typename RRng>
+		concept contiguous_bitwise_comparable =
+			tc::contiguous_range<LRng> && tc::contiguous_range<RRng> &&
+			tc::common_range<LRng> && tc::common_range<RRng> &&
+			std::is_same<std::remove_cv_t<tc::range_value_t<LRng>>, std::remove_cv_t<tc::range_value_t<RRng>>>::value &&
+			bitwise_comparable<std::remove_cv_t<tc::range_value_t<LRng>>>;
+	}
+}
@@ -14,11 +14,13 @@
 #include "../base/type_traits.h"
 #include "../base/generic_macros.h"
 #include "../base/tag_type.h"
+#include "../base/has_xxx.h"
 #include "../container/container_traits.h"
 
 #include <boost/range/traversal.hpp>
 
 #include <limits>
+#include <optional>
 
 namespace tc {
 	// forward definitions
@@ -255,5 +257,84 @@ namespace tc {
 
 	TC_HAS_EXPR(size, (T), size_raw(std::declval<T>()))
 	DEFINE_FN2(tc::size_raw, fn_size_raw)
+
+	namespace size_upper_bound_internal {
+		// tc::size_upper_bound() requires a range with either:
+		//  - a size, see above
+		//  - a size_upper_bound member function, e.g., formatted output, whose exact size is only known after formatting it
+		//  - a c_nMaxSize constant, e.g., numbers formatted into a fixed size buffer
+		template<typename Rng> requires
+			tc::has_size<Rng> || requires(Rng&& rng) { tc_move_if_owned(rng).size_upper_bound(); } || requires { std::remove_cvref_t<Rng>::c_nMaxSize; }
+		constexpr auto size_upper_bound(Rng&& rng) noexcept {
+			if constexpr( tc::has_size<Rng> ) {
+				return [&]() return_decltype_MAYTHROW(tc::size_raw(tc_move_if_owned(rng)));
+			} else if constexpr( requires { tc_move_if_owned(rng).size_upper_bound(); } ) {
+				return [&]() return_MAYTHROW(tc_move_if_owned(rng).size_upper_bound());
+			} else {
+				return [&]() return_decltype_noexcept(std::remove_cvref_t<Rng>::c_nMaxSize);
+			}
+		}
+	}
+
+	// Upper bound of the number of elements of a range, e.g., to reserve memory before appending the range to a container.
+	template<typename Rng>
+	[[nodiscard]] constexpr auto size_upper_bound(Rng&& rng) return_decltype_MAYTHROW(
+		size_upper_bound_internal::size_upper_bound(tc_move_if_owned(rng))()
+	)
+
+	TC_HAS_EXPR(size_upper_bound, (T), size_upper_bound(std::declval<T>()))
+
+	namespace no_adl {
+		// What is known about the number of elements of a range before iterating it.
+		struct size_bounds final {
+			std::size_t m_nLower = 0;
+			std::optional<std::size_t> m_onUpper; // std::nullopt if unbounded
+
+			constexpr bool exact() const& noexcept {
+				return m_onUpper && m_nLower == *m_onUpper;
+			}
+
+			// Bounds of the concatenation of two ranges.
+			friend constexpr size_bounds operator+(size_bounds const& lhs, size_bounds const& rhs) noexcept {
+				return {
+					lhs.m_nLower + rhs.m_nLower,
+					lhs.m_onUpper && rhs.m_onUpper && *rhs.m_onUpper <= std::numeric_limits<std::size_t>::max() - *lhs.m_onUpper
+						? std::optional<std::size_t>(*lhs.m_onUpper + *rhs.m_onUpper)
+						: std::nullopt
+				};
+			}
+
+			// Bounds of a range that contains a subset of the elements of a range with bounds *this, e.g., a filtered range.
+			constexpr size_bounds subset() const& noexcept {
+				return {0, m_onUpper};
+			}
+		};
+	}
+	using no_adl::size_bounds;
+
+	TC_HAS_MEM_FN_XXX_CONCEPT_DEF(size_hint, const&)
+
+	// Bounds of the number of elements of a range, e.g., to reserve memory before appending the range to a container:
+	//  - exact for ranges with a size
+	//  - reported by a size_hint member function returning tc::size_bounds, e.g., by range adaptors like tc::filter and tc::concat
+	//  - at most tc::size_upper_bound for ranges that only know that
+	//  - unknown otherwise
+	template<typename Rng>
+	[[nodiscard]] constexpr tc::size_bounds size_hint(Rng const& rng) MAYTHROW {
+		if constexpr( tc::has_size<Rng const&> ) {
+			auto const n = tc::explicit_cast<std::size_t>(tc::size_raw(rng));
+			return {n, n};
+		} else if constexpr( has_mem_fn_size_hint<Rng> ) {
+			return rng.size_hint(); // MAYTHROW
+		} else if constexpr( tc::has_size_upper_bound<Rng const&> ) {
+			return {0, tc::explicit_cast<std::size_t>(tc::size_upper_bound(rng))}; // MAYTHROW
+		} else {
+			return {};
+		}
+	}
+
+	// Ranges whose tc::size_hint may be better than unknown.
+	template<typename Rng>
+	concept has_size_hint = tc::has_size<Rng const&> || has_mem_fn_size_hint<std::remove_cvref_t<Rng>> || tc::has_size_upper_bound<Rng const&>;
 }
 
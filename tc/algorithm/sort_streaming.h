@@ -78,4 +78,38 @@ namespace tc {
 			return tc::constant<tc::continue_>();
 		});
 	}
+
+	template<typename Rng, typename Less = tc::fn_less>
+	auto sort_streaming_top_k(Rng&& rng, std::size_t const nK, Less&& less = Less()) noexcept {
+		// Notes:
+		//  * generates the nK smallest elements in ascending order
+		//  * not a stable sort algorithm
+		//  * rng is traversed once and may be a generator range, using O(nK) memory and O(n log nK) time
+		return tc::generator_range_output<tc::range_value_t<Rng const&>&>([
+			rng = tc::make_reference_or_value(std::forward<Rng>(rng)),
+			nK,
+			less = tc::decay_copy(std::forward<Less>(less))
+		](auto&& sink) MAYTHROW -> tc::common_type_t<decltype(tc::continue_if_not_break(sink, std::declval<tc::range_value_t<Rng const&>&>())), tc::constant<tc::continue_>> {
+			tc::vector<tc::range_value_t<Rng const&>> vec;
+			if( 0 < nK ) {
+				if constexpr( tc::has_size<Rng const&> ) {
+					tc::cont_reserve(vec, tc::min(nK, tc::explicit_cast<std::size_t>(tc::size_raw(*rng))));
+				}
+				// max-heap of the nK smallest elements seen so far
+				tc::for_each(*rng, [&](auto&& t) MAYTHROW {
+					if( tc::size_raw(vec) < nK ) {
+						tc::cont_emplace_back(vec, tc_move_if_owned(t)); // MAYTHROW
+						boost::range::push_heap(vec, less);
+					} else if( tc::invoke(less, tc::as_const(t), tc::front(vec)) ) {
+						tc::replace_heap(vec, tc::range_value_t<decltype(vec)>(tc_move_if_owned(t)), less); // MAYTHROW
+					}
+				});
+			}
+			boost::range::sort_heap(vec, less);
+			for( auto& t : vec ) {
+				tc_yield(sink, t); // MAYTHROW
+			}
+			return tc::constant<tc::continue_>();
+		});
+	}
 }
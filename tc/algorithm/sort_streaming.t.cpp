@@ -22,3 +22,13 @@ UNITTESTDEF( sort_streaming ) {
 		"9876543221100"
 	);
 }
+
+UNITTESTDEF( sort_streaming_top_k ) {
+	_ASSERTEQUAL( tc::make_str(tc::sort_streaming_top_k("5714926380", 4)), "0123" );
+	_ASSERTEQUAL( tc::make_str(tc::sort_streaming_top_k("5714926380", 4, tc::fn_greater())), "9876" );
+	_ASSERTEQUAL( tc::make_str(tc::sort_streaming_top_k("57149", 10)), "14579" );
+	_ASSERT( tc::empty(tc::make_str(tc::sort_streaming_top_k("57149", 0))) );
+
+	// input is a generator range, which is never materialized
+	_ASSERTEQUAL( tc::make_str(tc::sort_streaming_top_k(tc::make_generator_range("5714926380"), 3, tc::fn_greater())), "987" );
+}
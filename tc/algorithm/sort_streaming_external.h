@@ -0,0 +1,144 @@
+// think-cell public library
+//
+// Copyright (C) 2016-2023 think-cell Software GmbH
+//
+// Distributed under the Boost Software License, Version 1.0.
+// See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt
+
+#pragma once
+
+#include "../file.h"
+#include "algorithm.h"
+#include "sort_streaming.h"
+
+#include <boost/range/algorithm/heap_algorithm.hpp>
+
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <utility>
+
+namespace tc {
+	namespace sort_streaming_external_detail {
+		namespace no_adl {
+			// Sorted run in the spill file, read back in blocks.
+			template<typename T>
+			struct run_reader final {
+				run_reader(std::uint64_t const nOffset, std::size_t const nCount, std::size_t const nBlockSize) noexcept
+					: m_nOffset(nOffset)
+					, m_nRemaining(nCount)
+					, m_nBlockSize(tc::min(nBlockSize, nCount))
+					, m_pt(std::make_unique_for_overwrite<T[]>(m_nBlockSize))
+				{}
+
+				T& front() & noexcept {
+					_ASSERT(m_iBlock < m_nBlock);
+					return m_pt[m_iBlock];
+				}
+
+				// Returns false if the run is exhausted.
+				bool pop_front(tc::temp_file& file) & MAYTHROW {
+					_ASSERT(m_iBlock < m_nBlock);
+					return ++m_iBlock < m_nBlock || refill(file); // THROW(tc::file_failure)
+				}
+
+				bool refill(tc::temp_file& file) & MAYTHROW {
+					m_nBlock = tc::min(m_nBlockSize, m_nRemaining);
+					m_iBlock = 0;
+					if( 0 == m_nBlock ) return false;
+					file.read(m_nOffset, tc::range_as_blob(tc::make_iterator_range(m_pt.get(), m_pt.get() + m_nBlock))); // THROW(tc::file_failure)
+					m_nOffset += m_nBlock * sizeof(T);
+					m_nRemaining -= m_nBlock;
+					return true;
+				}
+
+			private:
+				std::uint64_t m_nOffset;
+				std::size_t m_nRemaining;
+				std::size_t m_nBlockSize;
+				std::unique_ptr<T[]> m_pt;
+				std::size_t m_nBlock = 0;
+				std::size_t m_iBlock = 0;
+			};
+		}
+		using no_adl::run_reader;
+	}
+
+	template<typename Rng, typename Less = tc::fn_less>
+	auto sort_streaming_external(Rng&& rng, std::size_t const nMemoryBytes, Less&& less = Less()) noexcept {
+		// Notes:
+		//  * same output as tc::sort_streaming(rng, less), but holds at most about nMemoryBytes of elements in memory
+		//  * sorted runs that fill the memory budget are spilled to an anonymous temporary file as blobs, so the element type must be trivially copyable
+		//  * the runs are merged back in blocks, so the first element is generated after reading only the first block of every run
+		//  * not a stable sort algorithm
+		//  * THROW(tc::file_failure) while iterating, if spilling fails
+		using T = tc::range_value_t<Rng const&>;
+		static_assert(std::is_trivially_copyable<T>::value && std::is_default_constructible<T>::value);
+		return tc::generator_range_output<T&>([
+			rng = tc::make_reference_or_value(std::forward<Rng>(rng)),
+			nBufferSize = tc::max(nMemoryBytes / sizeof(T), std::size_t(1)),
+			less = tc::decay_copy(std::forward<Less>(less))
+		](auto&& sink) MAYTHROW -> tc::common_type_t<decltype(tc::continue_if_not_break(sink, std::declval<T&>())), tc::constant<tc::continue_>> {
+			std::optional<tc::temp_file> ofile;
+			tc::vector<std::pair<std::uint64_t, std::size_t>> vecpairnOffsetnCount;
+			tc::vector<T> vecBuffer; // grows on demand, so that small inputs do not allocate the whole memory budget
+			// Not tc::sort_inplace, whose radix sort would double the memory with a scratch buffer as large as the run.
+			auto const SortBuffer = [&]() noexcept {
+				std::sort(tc::begin(vecBuffer), tc::end(vecBuffer), std::ref(less));
+			};
+			auto Spill = [&]() MAYTHROW {
+				SortBuffer();
+				if( !ofile ) ofile.emplace(); // THROW(tc::file_failure)
+				tc::cont_emplace_back(vecpairnOffsetnCount, ofile->size(), tc::size(vecBuffer));
+				ofile->append(tc::range_as_blob(vecBuffer)); // THROW(tc::file_failure)
+				vecBuffer.clear();
+			};
+
+			tc::for_each(*rng, [&](auto&& t) MAYTHROW {
+				if( tc::size_raw(vecBuffer) == nBufferSize ) {
+					Spill(); // THROW(tc::file_failure)
+				} else if( tc::size_raw(vecBuffer) == vecBuffer.capacity() ) {
+					NOBADALLOC(vecBuffer.reserve(tc::min(tc::max(2 * vecBuffer.capacity(), std::size_t(16)), nBufferSize))); // not beyond the budget
+				}
+				tc::cont_emplace_back(vecBuffer, tc_move_if_owned(t));
+			});
+
+			if( !ofile ) {
+				// everything fits into memory
+				SortBuffer();
+				for( auto& t : vecBuffer ) {
+					tc_yield(sink, t); // MAYTHROW
+				}
+				return tc::constant<tc::continue_>();
+			}
+			if( !tc::empty(vecBuffer) ) Spill(); // THROW(tc::file_failure)
+			tc::vector<T>().swap(vecBuffer); // release the memory before it is used for the read blocks
+
+			auto const nBlockSize = tc::max(nBufferSize / tc::size(vecpairnOffsetnCount), std::size_t(1));
+			tc::vector<sort_streaming_external_detail::run_reader<T>> vecrunreader;
+			tc::vector<std::size_t> vecnHeap;
+			for( auto const& [nOffset, nCount] : vecpairnOffsetnCount ) {
+				tc::cont_emplace_back(vecnHeap, tc::size(vecrunreader));
+				VERIFY(tc::cont_emplace_back(vecrunreader, nOffset, nCount, nBlockSize).refill(*ofile)); // THROW(tc::file_failure)
+			}
+
+			// std heap algorithm using less create max heap, we need min heap. Hence, we use greater.
+			auto const greater = [&](std::size_t const nLhs, std::size_t const nRhs) noexcept {
+				return tc::invoke(less, tc::as_const(vecrunreader[nRhs].front()), tc::as_const(vecrunreader[nLhs].front()));
+			};
+			boost::range::make_heap(vecnHeap, greater);
+			while( !tc::empty(vecnHeap) ) {
+				auto const n = tc::front(vecnHeap);
+				tc_yield(sink, vecrunreader[n].front()); // MAYTHROW
+				if( vecrunreader[n].pop_front(*ofile) ) { // THROW(tc::file_failure)
+					tc::replace_heap(vecnHeap, n, greater);
+				} else {
+					boost::range::pop_heap(vecnHeap, greater);
+					tc::drop_last_inplace(vecnHeap);
+				}
+			}
+			return tc::constant<tc::continue_>();
+		});
+	}
+}
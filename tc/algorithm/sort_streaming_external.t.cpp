@@ -0,0 +1,41 @@
+// think-cell public library
+//
+// Copyright (C) 2016-2023 think-cell Software GmbH
+//
+// Distributed under the Boost Software License, Version 1.0.
+// See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt
+
+#include "../base/assert_defs.h"
+#include "../unittest.h"
+#include "../range/iota_range.h"
+#include "sort_streaming_external.h"
+
+UNITTESTDEF( sort_streaming_external ) {
+	tc::vector<int> vecn;
+	unsigned int nRandom = 1;
+	for( int i = 0; i < 10000; ++i ) {
+		nRandom = nRandom * 1103515245 + 12345;
+		tc::cont_emplace_back(vecn, tc::explicit_cast<int>(nRandom >> 16) % 5000 - 2500);
+	}
+	auto vecnSorted = vecn;
+	tc::sort_inplace(vecnSorted);
+
+	// spills 40 runs
+	_ASSERT( tc::equal(tc::sort_streaming_external(vecn, 1000), vecnSorted) );
+	// a single element per run
+	_ASSERT( tc::equal(tc::sort_streaming_external(tc::begin_next<tc::return_take>(vecn, 100), 1), tc::make_vector(tc::sort_streaming(tc::begin_next<tc::return_take>(vecn, 100)))) );
+	// fits into memory
+	_ASSERT( tc::equal(tc::sort_streaming_external(vecn, 1000000), vecnSorted) );
+	_ASSERT( tc::equal(tc::sort_streaming_external(vecn, 1000, tc::fn_greater()), tc::reverse(vecnSorted)) );
+	_ASSERT( tc::empty(tc::make_vector(tc::sort_streaming_external(tc::vector<int>(), 1000))) );
+	// the memory budget is a limit, not an allocation size
+	_ASSERT( tc::equal(tc::sort_streaming_external(tc::begin_next<tc::return_take>(vecn, 10), std::numeric_limits<std::size_t>::max() / 2), tc::make_vector(tc::sort_streaming(tc::begin_next<tc::return_take>(vecn, 10)))) );
+
+	// generator input, stopped early
+	int nCount = 0;
+	tc::for_each(tc::sort_streaming_external(tc::make_generator_range(vecn), 1000), [&](int& n) noexcept {
+		_ASSERTEQUAL(n, vecnSorted[nCount]);
+		return tc::continue_if(10 != ++nCount);
+	});
+	_ASSERTEQUAL(nCount, 10);
+}
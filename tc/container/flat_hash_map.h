@@ -0,0 +1,653 @@
+// think-cell public library
+//
+// Copyright (C) 2016-2023 think-cell Software GmbH
+//
+// Distributed under the Boost Software License, Version 1.0.
+// See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt
+
+#pragma once
+
+#include "../base/assert_defs.h"
+#include "../base/assign.h"
+#include "../base/bitfield.h"
+#include "../base/invoke.h"
+#include "../base/tc_move.h"
+#include "../algorithm/simd.h"
+#include "../algorithm/append.h"
+#include "insert.h"
+
+#include <bit>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <utility>
+
+// Open-addressing hash containers in the style of SwissTable: the slots are stored in a single flat array,
+// next to an array of one control byte per slot. A control byte is either empty, deleted or holds the low
+// 7 bits of the hash of the element in the slot, so a probe compares a whole group of 16 control bytes at once
+// and only touches slots whose hash bits match.
+namespace tc {
+	namespace flat_hash_detail {
+		using ctrl_t = signed char;
+
+		inline constexpr ctrl_t c_ctrlEmpty = -128;
+		inline constexpr ctrl_t c_ctrlDeleted = -2;
+		inline constexpr ctrl_t c_ctrlSentinel = -1; // marks the end for iteration, never matched by a probe
+		static_assert(c_ctrlEmpty < c_ctrlDeleted && c_ctrlDeleted < c_ctrlSentinel, "empty or deleted is tested with ctrl < c_ctrlSentinel");
+
+		inline constexpr std::size_t c_nGroupWidth = 16;
+		// The first c_nGroupWidth-1 control bytes are cloned after the sentinel, so a group can be loaded at any slot without wrapping around.
+		inline constexpr std::size_t c_nClonedBytes = c_nGroupWidth - 1;
+
+		// Control bytes of a table without allocation. Lookups see an empty slot and iteration sees the sentinel.
+		alignas(c_nGroupWidth) inline constexpr ctrl_t c_actrlEmptyGroup[c_nGroupWidth] = {
+			c_ctrlSentinel, c_ctrlEmpty, c_ctrlEmpty, c_ctrlEmpty, c_ctrlEmpty, c_ctrlEmpty, c_ctrlEmpty, c_ctrlEmpty,
+			c_ctrlEmpty, c_ctrlEmpty, c_ctrlEmpty, c_ctrlEmpty, c_ctrlEmpty, c_ctrlEmpty, c_ctrlEmpty, c_ctrlEmpty
+		};
+
+		// Weak hashes such as std::hash<int>, which is the identity, leave the high bits empty. Spread the entropy over all bits.
+		inline std::size_t mix(std::size_t const nHash) noexcept {
+			std::uint64_t const n = tc::explicit_cast<std::uint64_t>(nHash) * UINT64_C(0x9e3779b97f4a7c15);
+			return static_cast<std::size_t>(n ^ (n >> 32));
+		}
+
+		// The low 7 bits of the hash go to the control byte, the rest select the first group to probe.
+		inline std::size_t h1(std::size_t const nHash) noexcept {
+			return nHash >> 7;
+		}
+
+		inline ctrl_t h2(std::size_t const nHash) noexcept {
+			return static_cast<ctrl_t>(nHash & 0x7f);
+		}
+
+		// Capacities are of the form 2^n-1, so that they can be used as mask.
+		inline constexpr std::size_t normalize_capacity(std::size_t const n) noexcept {
+			return 0 == n ? 1 : ~std::size_t(0) >> std::countl_zero(n);
+		}
+
+		// Maximum load factor is 7/8. Tables smaller than a group can be filled completely, because the group loaded
+		// by a probe always contains empty control bytes beyond the cloned ones.
+		inline constexpr std::size_t capacity_to_growth(std::size_t const nCapacity) noexcept {
+			return nCapacity - nCapacity / 8;
+		}
+
+		inline constexpr std::size_t growth_to_lower_bound_capacity(std::size_t const nGrowth) noexcept {
+			return nGrowth + (0 == nGrowth ? 0 : (nGrowth - 1) / 7);
+		}
+
+		namespace no_adl {
+			// Bit mask with one bit per control byte of a group.
+			struct group final {
+				explicit group(ctrl_t const* const pctrl) noexcept
+#ifdef TC_SIMD_X64
+					: m_ctrl(_mm_loadu_si128(reinterpret_cast<__m128i const*>(pctrl)))
+				{}
+#else
+				{
+					std::memcpy(m_actrl, pctrl, c_nGroupWidth);
+				}
+#endif
+
+				unsigned int match(ctrl_t const ctrl) const& noexcept {
+#ifdef TC_SIMD_X64
+					return static_cast<unsigned int>(_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_set1_epi8(ctrl), m_ctrl)));
+#else
+					return mask([&](ctrl_t const ctrlSlot) noexcept { return ctrl == ctrlSlot; });
+#endif
+				}
+
+				unsigned int match_empty() const& noexcept {
+					return match(c_ctrlEmpty);
+				}
+
+				unsigned int match_empty_or_deleted() const& noexcept {
+#ifdef TC_SIMD_X64
+					return static_cast<unsigned int>(_mm_movemask_epi8(_mm_cmpgt_epi8(_mm_set1_epi8(c_ctrlSentinel), m_ctrl)));
+#else
+					return mask([](ctrl_t const ctrlSlot) noexcept { return ctrlSlot < c_ctrlSentinel; });
+#endif
+				}
+
+				int count_leading_empty_or_deleted() const& noexcept {
+					return std::countr_one(match_empty_or_deleted());
+				}
+
+			private:
+#ifdef TC_SIMD_X64
+				__m128i m_ctrl;
+#else
+				template<typename Pred>
+				unsigned int mask(Pred pred) const& noexcept {
+					unsigned int nMask = 0;
+					for( std::size_t i = 0; i < c_nGroupWidth; ++i ) {
+						if( pred(m_actrl[i]) ) nMask |= 1u << i;
+					}
+					return nMask;
+				}
+
+				ctrl_t m_actrl[c_nGroupWidth];
+#endif
+			};
+
+			// Triangular probing visits every group exactly once, if the number of groups is a power of 2.
+			struct probe_seq final {
+				probe_seq(std::size_t const nHash, std::size_t const nCapacity) noexcept
+					: m_nMask(nCapacity)
+					, m_nOffset(h1(nHash) & nCapacity)
+				{}
+
+				std::size_t offset() const& noexcept {
+					return m_nOffset;
+				}
+
+				std::size_t offset(int const i) const& noexcept {
+					return (m_nOffset + tc::explicit_cast<std::size_t>(i)) & m_nMask;
+				}
+
+				void next() & noexcept {
+					m_nIndex += c_nGroupWidth;
+					m_nOffset = (m_nOffset + m_nIndex) & m_nMask;
+					_ASSERT(m_nIndex <= m_nMask); // table is full
+				}
+
+			private:
+				std::size_t m_nMask;
+				std::size_t m_nOffset;
+				std::size_t m_nIndex = 0;
+			};
+
+			template<typename Key>
+			struct set_policy final {
+				using key_type = Key;
+				using value_type = Key;
+				using element_type = Key const; // elements of a set must not be modified
+
+				static Key const& key(value_type const& val) noexcept {
+					return val;
+				}
+
+				template<typename Arg> requires std::is_same<Arg, Key>::value
+				static Key const& key_from_args(Arg const& arg) noexcept {
+					return arg;
+				}
+			};
+
+			template<typename Key, typename T>
+			struct map_policy final {
+				using key_type = Key;
+				using mapped_type = T;
+				using value_type = std::pair<Key const, T>;
+				using element_type = value_type;
+
+				static Key const& key(value_type const& val) noexcept {
+					return val.first;
+				}
+
+				template<typename Pair> requires tc::instance<Pair, std::pair> && std::is_same<tc::decay_t<typename Pair::first_type>, Key>::value
+				static Key const& key_from_args(Pair const& pair) noexcept {
+					return pair.first;
+				}
+
+				template<typename K, typename V> requires std::is_same<K, Key>::value
+				static Key const& key_from_args(K const& key, V const&) noexcept {
+					return key;
+				}
+			};
+
+			template<typename Policy, typename Hash, typename KeyEqual>
+			struct flat_hash_table;
+
+			template<typename Element>
+			struct flat_hash_iterator {
+				using iterator_category = std::forward_iterator_tag;
+				using value_type = std::remove_const_t<Element>;
+				using difference_type = std::ptrdiff_t;
+				using pointer = Element*;
+				using reference = Element&;
+
+				flat_hash_iterator() noexcept = default;
+
+				// Skips to the next full slot or to the sentinel.
+				flat_hash_iterator(ctrl_t const* const pctrl, Element* const pslot) noexcept
+					: m_pctrl(pctrl)
+					, m_pslot(pslot)
+				{
+					skip_empty_or_deleted();
+				}
+
+				template<typename ElementOther> requires std::is_same<ElementOther const, Element>::value && (!std::is_same<ElementOther, Element>::value)
+				flat_hash_iterator(flat_hash_iterator<ElementOther> const& it) noexcept
+					: m_pctrl(it.m_pctrl)
+					, m_pslot(it.m_pslot)
+				{}
+
+				reference operator*() const& noexcept {
+					_ASSERTDEBUG(c_ctrlSentinel < *m_pctrl);
+					return *m_pslot;
+				}
+
+				pointer operator->() const& noexcept {
+					return std::addressof(**this);
+				}
+
+				flat_hash_iterator& operator++() & noexcept {
+					_ASSERTDEBUG(c_ctrlSentinel < *m_pctrl);
+					++m_pctrl;
+					++m_pslot;
+					skip_empty_or_deleted();
+					return *this;
+				}
+
+				flat_hash_iterator operator++(int) & noexcept {
+					auto it = *this;
+					++*this;
+					return it;
+				}
+
+				friend bool operator==(flat_hash_iterator const& lhs, flat_hash_iterator const& rhs) noexcept {
+					return lhs.m_pctrl == rhs.m_pctrl;
+				}
+
+			private:
+				template<typename>
+				friend struct flat_hash_iterator;
+				template<typename, typename, typename>
+				friend struct flat_hash_table;
+
+				void skip_empty_or_deleted() & noexcept {
+					while( *m_pctrl < c_ctrlSentinel ) {
+						// The group may extend beyond the sentinel into the cloned bytes, but the sentinel stops the count.
+						auto const nShift = group(m_pctrl).count_leading_empty_or_deleted();
+						m_pctrl += nShift;
+						m_pslot += nShift;
+					}
+				}
+
+				ctrl_t const* m_pctrl = nullptr;
+				Element* m_pslot = nullptr;
+			};
+
+			template<typename Policy, typename Hash, typename KeyEqual>
+			struct flat_hash_table final {
+			private:
+				using element_type = typename Policy::element_type;
+
+			public:
+				using key_type = typename Policy::key_type;
+				using value_type = typename Policy::value_type;
+				using hasher = Hash;
+				using key_equal = KeyEqual;
+				using size_type = std::size_t;
+				using difference_type = std::ptrdiff_t;
+				using reference = element_type&;
+				using const_reference = value_type const&;
+				using iterator = flat_hash_iterator<element_type>;
+				using const_iterator = flat_hash_iterator<value_type const>;
+
+				flat_hash_table() noexcept = default;
+
+				explicit flat_hash_table(size_type const n, Hash const& hash = Hash(), KeyEqual const& equal = KeyEqual()) MAYTHROW
+					: m_hash(hash)
+					, m_equal(equal)
+				{
+					reserve(n); // MAYTHROW
+				}
+
+				flat_hash_table(flat_hash_table const& other) MAYTHROW
+					: flat_hash_table(other.m_nSize, other.m_hash, other.m_equal) // delegating constructor, so the destructor cleans up if copying an element throws
+				{
+					for( auto const& val : other ) {
+						auto const nHash = hash_of(Policy::key(val));
+						auto const i = find_first_non_full(nHash);
+						std::construct_at(m_pslot + i, val); // MAYTHROW
+						commit_insert(i, nHash);
+					}
+				}
+
+				flat_hash_table(flat_hash_table&& other) noexcept
+					: m_pctrl(std::exchange(other.m_pctrl, empty_group()))
+					, m_pslot(std::exchange(other.m_pslot, nullptr))
+					, m_nCapacity(std::exchange(other.m_nCapacity, 0))
+					, m_nSize(std::exchange(other.m_nSize, 0))
+					, m_nGrowthLeft(std::exchange(other.m_nGrowthLeft, 0))
+					, m_hash(other.m_hash)
+					, m_equal(other.m_equal)
+				{}
+
+				flat_hash_table& operator=(flat_hash_table other) & noexcept {
+					swap(other);
+					return *this;
+				}
+
+				~flat_hash_table() {
+					destroy_and_deallocate();
+				}
+
+				void swap(flat_hash_table& other) & noexcept {
+					using std::swap;
+					swap(m_pctrl, other.m_pctrl);
+					swap(m_pslot, other.m_pslot);
+					swap(m_nCapacity, other.m_nCapacity);
+					swap(m_nSize, other.m_nSize);
+					swap(m_nGrowthLeft, other.m_nGrowthLeft);
+					swap(m_hash, other.m_hash);
+					swap(m_equal, other.m_equal);
+				}
+
+				friend void swap(flat_hash_table& lhs, flat_hash_table& rhs) noexcept {
+					lhs.swap(rhs);
+				}
+
+				// query state
+				iterator begin() & noexcept {
+					return iterator(m_pctrl, m_pslot);
+				}
+				const_iterator begin() const& noexcept {
+					return const_iterator(m_pctrl, m_pslot);
+				}
+				iterator end() & noexcept {
+					return iterator_at(m_nCapacity);
+				}
+				const_iterator end() const& noexcept {
+					return tc::as_mutable(*this).end();
+				}
+
+				size_type size() const& noexcept {
+					return m_nSize;
+				}
+				bool empty() const& noexcept {
+					return 0 == m_nSize;
+				}
+				size_type capacity() const& noexcept {
+					return m_nCapacity;
+				}
+
+				hasher hash_function() const& noexcept {
+					return m_hash;
+				}
+				key_equal key_eq() const& noexcept {
+					return m_equal;
+				}
+
+				// lookup
+				template<typename K>
+				iterator find(K const& key) & noexcept {
+					if( auto const pslot = find_slot(key, hash_of(key)) ) {
+						return iterator_at(tc::explicit_cast<std::size_t>(pslot - m_pslot));
+					} else {
+						return end();
+					}
+				}
+				template<typename K>
+				const_iterator find(K const& key) const& noexcept {
+					return tc::as_mutable(*this).find(key);
+				}
+
+				template<typename K>
+				bool contains(K const& key) const& noexcept {
+					return nullptr != find_slot(key, hash_of(key));
+				}
+
+				template<typename K>
+				size_type count(K const& key) const& noexcept {
+					return contains(key) ? 1 : 0;
+				}
+
+				// insert
+				template<typename... Args>
+				std::pair<iterator, bool> emplace(Args&&... args) & MAYTHROW {
+					if constexpr( requires { Policy::key_from_args(tc::as_const(args)...); } ) {
+						// No need to construct an element, if it is already in the table.
+						return emplace_with_key(Policy::key_from_args(tc::as_const(args)...), std::forward<Args>(args)...); // MAYTHROW
+					} else {
+						value_type val(std::forward<Args>(args)...); // MAYTHROW
+						return emplace_with_key(Policy::key(val), tc_move(val)); // MAYTHROW
+					}
+				}
+
+				std::pair<iterator, bool> insert(value_type const& val) & MAYTHROW {
+					return emplace(val);
+				}
+				std::pair<iterator, bool> insert(value_type&& val) & MAYTHROW {
+					return emplace(tc_move(val));
+				}
+
+				// The element is constructed piecewise from key and args, only if the key is not in the table yet.
+				template<typename K, typename... Args> requires requires { typename Policy::mapped_type; }
+				std::pair<iterator, bool> try_emplace(K&& key, Args&&... args) & MAYTHROW {
+					return emplace_with_key(key, std::piecewise_construct, std::forward_as_tuple(std::forward<K>(key)), std::forward_as_tuple(std::forward<Args>(args)...)); // MAYTHROW
+				}
+
+				template<typename K> requires requires { typename Policy::mapped_type; }
+				auto& operator[](K&& key) & MAYTHROW {
+					return try_emplace(std::forward<K>(key)).first->second; // MAYTHROW
+				}
+
+				void reserve(size_type const n) & MAYTHROW {
+					if( capacity_to_growth(m_nCapacity) < n ) {
+						rehash(normalize_capacity(growth_to_lower_bound_capacity(n))); // MAYTHROW
+					}
+				}
+
+				// erase
+				// Erasing does not move other elements, so all other iterators stay valid.
+				iterator erase(const_iterator it) & noexcept {
+					auto const i = index_of(it);
+					++it;
+					erase_at(i);
+					return iterator_at(index_of(it));
+				}
+				iterator erase(iterator it) & noexcept requires (!std::is_same<iterator, const_iterator>::value) {
+					return erase(const_iterator(it));
+				}
+
+				iterator erase(const_iterator itBegin, const_iterator const itEnd) & noexcept {
+					while( itBegin != itEnd ) {
+						auto const i = index_of(itBegin);
+						++itBegin;
+						erase_at(i);
+					}
+					return iterator_at(index_of(itEnd));
+				}
+
+				size_type erase(key_type const& key) & noexcept {
+					if( auto const pslot = find_slot(key, hash_of(key)) ) {
+						erase_at(tc::explicit_cast<std::size_t>(pslot - m_pslot));
+						return 1;
+					} else {
+						return 0;
+					}
+				}
+
+				void clear() & noexcept {
+					destroy_all();
+					if( 0 < m_nCapacity ) {
+						reset_ctrl();
+					}
+				}
+
+			private:
+				static ctrl_t* empty_group() noexcept {
+					return const_cast<ctrl_t*>(c_actrlEmptyGroup); // never written, because m_nGrowthLeft is 0
+				}
+
+				// Single allocation for control bytes followed by slots.
+				static constexpr std::size_t c_nAlignment = tc::max(alignof(value_type), c_nGroupWidth);
+
+				static std::size_t slot_offset(std::size_t const nCapacity) noexcept {
+					return (nCapacity + 1 + c_nClonedBytes + alignof(value_type) - 1) / alignof(value_type) * alignof(value_type);
+				}
+
+				static std::size_t alloc_size(std::size_t const nCapacity) noexcept {
+					return slot_offset(nCapacity) + nCapacity * sizeof(value_type);
+				}
+
+				template<typename K>
+				std::size_t hash_of(K const& key) const& noexcept {
+					return mix(tc::invoke(m_hash, key));
+				}
+
+				iterator iterator_at(std::size_t const i) & noexcept {
+					iterator it;
+					it.m_pctrl = m_pctrl + i;
+					it.m_pslot = m_pslot + i;
+					return it;
+				}
+
+				std::size_t index_of(const_iterator const& it) const& noexcept {
+					return tc::explicit_cast<std::size_t>(it.m_pctrl - m_pctrl);
+				}
+
+				template<typename K>
+				value_type* find_slot(K const& key, std::size_t const nHash) const& noexcept {
+					for( probe_seq seq(nHash, m_nCapacity);; seq.next() ) {
+						group const grp(m_pctrl + seq.offset());
+						for( auto nMask = grp.match(h2(nHash)); 0 != nMask; nMask &= nMask - 1 ) {
+							auto const pslot = m_pslot + seq.offset(tc::index_of_least_significant_bit(nMask));
+							if( tc::invoke(m_equal, key, Policy::key(*pslot)) ) return pslot;
+						}
+						if( 0 != grp.match_empty() ) return nullptr;
+					}
+				}
+
+				std::size_t find_first_non_full(std::size_t const nHash) const& noexcept {
+					for( probe_seq seq(nHash, m_nCapacity);; seq.next() ) {
+						if( auto const nMask = group(m_pctrl + seq.offset()).match_empty_or_deleted() ) {
+							return seq.offset(tc::index_of_least_significant_bit(nMask));
+						}
+					}
+				}
+
+				template<typename K, typename... Args>
+				std::pair<iterator, bool> emplace_with_key(K const& key, Args&&... args) & MAYTHROW {
+					auto const nHash = hash_of(key);
+					if( auto const pslot = find_slot(key, nHash) ) {
+						return std::make_pair(iterator_at(tc::explicit_cast<std::size_t>(pslot - m_pslot)), false);
+					}
+					auto i = find_first_non_full(nHash);
+					if( 0 == m_nGrowthLeft && c_ctrlDeleted != m_pctrl[i] ) {
+						// Reclaim the tombstones, if they make up a large part of the table, otherwise grow.
+						rehash(c_nGroupWidth < m_nCapacity && m_nSize * 32 <= m_nCapacity * 25 ? m_nCapacity : m_nCapacity * 2 + 1); // MAYTHROW
+						i = find_first_non_full(nHash);
+					}
+					std::construct_at(m_pslot + i, std::forward<Args>(args)...); // MAYTHROW
+					commit_insert(i, nHash);
+					return std::make_pair(iterator_at(i), true);
+				}
+
+				void commit_insert(std::size_t const i, std::size_t const nHash) & noexcept {
+					if( c_ctrlEmpty == m_pctrl[i] ) {
+						_ASSERT(0 < m_nGrowthLeft);
+						--m_nGrowthLeft;
+					}
+					set_ctrl(i, h2(nHash));
+					++m_nSize;
+				}
+
+				void set_ctrl(std::size_t const i, ctrl_t const ctrl) & noexcept {
+					_ASSERT(i < m_nCapacity);
+					m_pctrl[i] = ctrl;
+					m_pctrl[((i - c_nClonedBytes) & m_nCapacity) + (c_nClonedBytes & m_nCapacity)] = ctrl;
+				}
+
+				void erase_at(std::size_t const i) & noexcept {
+					_ASSERT(c_ctrlSentinel < m_pctrl[i]);
+					std::destroy_at(m_pslot + i);
+					--m_nSize;
+					// If there has never been a full group around the slot, no probe has ever continued past it,
+					// so the slot can be marked empty instead of leaving a tombstone.
+					auto const nEmptyBefore = group(m_pctrl + ((i - c_nGroupWidth) & m_nCapacity)).match_empty();
+					auto const nEmptyAfter = group(m_pctrl + i).match_empty();
+					if( 0 != nEmptyBefore && 0 != nEmptyAfter &&
+						tc::explicit_cast<std::size_t>(std::countr_zero(nEmptyAfter) + std::countl_zero(static_cast<std::uint16_t>(nEmptyBefore))) < c_nGroupWidth
+					) {
+						set_ctrl(i, c_ctrlEmpty);
+						++m_nGrowthLeft;
+					} else {
+						set_ctrl(i, c_ctrlDeleted);
+					}
+				}
+
+				void reset_ctrl() & noexcept {
+					std::memset(m_pctrl, c_ctrlEmpty, m_nCapacity + 1 + c_nClonedBytes);
+					m_pctrl[m_nCapacity] = c_ctrlSentinel;
+					m_nGrowthLeft = capacity_to_growth(m_nCapacity) - m_nSize;
+				}
+
+				void destroy_all() & noexcept {
+					if constexpr( !std::is_trivially_destructible<value_type>::value ) {
+						for( auto it = begin(); it != end(); ++it ) {
+							std::destroy_at(m_pslot + index_of(it));
+						}
+					}
+					m_nSize = 0;
+				}
+
+				void destroy_and_deallocate() & noexcept {
+					if( 0 < m_nCapacity ) {
+						destroy_all();
+						::operator delete(m_pctrl, alloc_size(m_nCapacity), std::align_val_t(c_nAlignment));
+					}
+				}
+
+				void rehash(std::size_t const nCapacity) & MAYTHROW {
+					_ASSERT(capacity_to_growth(nCapacity) >= m_nSize);
+					flat_hash_table tbl;
+					tbl.m_pctrl = static_cast<ctrl_t*>(::operator new(alloc_size(nCapacity), std::align_val_t(c_nAlignment))); // MAYTHROW
+					tbl.m_pslot = reinterpret_cast<value_type*>(reinterpret_cast<unsigned char*>(tbl.m_pctrl) + slot_offset(nCapacity));
+					tbl.m_nCapacity = nCapacity;
+					tbl.reset_ctrl();
+					for( auto it = begin(); it != end(); ++it ) {
+						auto const nHash = hash_of(Policy::key(*it));
+						auto const i = tbl.find_first_non_full(nHash);
+						std::construct_at(tbl.m_pslot + i, std::move_if_noexcept(*(m_pslot + index_of(it)))); // MAYTHROW
+						tbl.commit_insert(i, nHash);
+					}
+					tbl.m_hash = m_hash;
+					tbl.m_equal = m_equal;
+					swap(tbl);
+				}
+
+				ctrl_t* m_pctrl = empty_group();
+				value_type* m_pslot = nullptr;
+				std::size_t m_nCapacity = 0;
+				std::size_t m_nSize = 0;
+				std::size_t m_nGrowthLeft = 0;
+				Hash m_hash;
+				KeyEqual m_equal;
+
+				// tc::append inserts every element, which must not be in the table yet.
+				struct [[nodiscard]] appender final {
+					using guaranteed_break_or_continue = tc::constant<tc::continue_>;
+					flat_hash_table& m_cont;
+
+					template<typename T>
+					void operator()(T&& t) const& MAYTHROW {
+						tc::cont_must_emplace(m_cont, std::forward<T>(t)); // MAYTHROW
+					}
+
+					template<tc::has_size Rng>
+					void chunk(Rng&& rng) const& MAYTHROW {
+						m_cont.reserve(m_cont.size() + tc::size(rng)); // MAYTHROW
+						tc::for_each(std::forward<Rng>(rng), [&](auto&& t) MAYTHROW {
+							tc::cont_must_emplace(m_cont, tc_move_if_owned(t)); // MAYTHROW
+						});
+					}
+				};
+
+				friend appender appender_impl(flat_hash_table& cont) noexcept {
+					return {cont};
+				}
+			};
+		}
+	}
+
+	template<typename Key, typename Hash=std::hash<Key>, typename KeyEqual=tc::fn_equal_to>
+	using flat_hash_set=flat_hash_detail::no_adl::flat_hash_table<flat_hash_detail::no_adl::set_policy<Key>, Hash, KeyEqual>;
+
+	template<typename Key, typename T, typename Hash=std::hash<Key>, typename KeyEqual=tc::fn_equal_to>
+	using flat_hash_map=flat_hash_detail::no_adl::flat_hash_table<flat_hash_detail::no_adl::map_policy<Key, T>, Hash, KeyEqual>;
+}
@@ -0,0 +1,91 @@
+// think-cell public library
+//
+// Copyright (C) 2016-2023 think-cell Software GmbH
+//
+// Distributed under the Boost Software License, Version 1.0.
+// See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt
+
+#include "../base/assert_defs.h"
+#include "../unittest.h"
+#include "../algorithm/algorithm.h"
+#include "../algorithm/append.h"
+#include "../algorithm/filter_inplace.h"
+#include "../range/iota_range.h"
+#include "flat_hash_map.h"
+
+#include <string>
+
+UNITTESTDEF(flat_hash_set) {
+	tc::flat_hash_set<int> setn;
+	_ASSERT(tc::empty(setn));
+	_ASSERT(!tc::cont_find<tc::return_bool>(setn, 17));
+
+	for( int n = 0; n < 1000; ++n ) {
+		_ASSERT(tc::cont_try_emplace(setn, n * 3).second);
+	}
+	_ASSERTEQUAL(tc::size(setn), 1000);
+	_ASSERT(!tc::cont_try_emplace(setn, 999).second);
+	for( int n = 0; n < 3000; ++n ) {
+		_ASSERTEQUAL(tc::cont_find<tc::return_bool>(setn, n), 0 == n % 3);
+	}
+
+	// erasing leaves the other elements in place
+	tc::filter_inplace(setn, [](int const n) noexcept { return 0 == n % 2; });
+	_ASSERTEQUAL(tc::size(setn), 500);
+	for( int n = 0; n < 3000; ++n ) {
+		_ASSERTEQUAL(tc::cont_find<tc::return_bool>(setn, n), 0 == n % 6);
+	}
+
+	// reinsert into slots with tombstones
+	for( int n = 0; n < 3000; n += 3 ) {
+		tc::cont_try_emplace(setn, n);
+	}
+	_ASSERTEQUAL(tc::size(setn), 1000);
+	int nSum = 0;
+	tc::for_each(setn, [&](int const n) noexcept { nSum += n; });
+	_ASSERTEQUAL(nSum, 3 * 999 * 1000 / 2);
+
+	auto setnCopy = setn;
+	setn.clear();
+	_ASSERT(tc::empty(setn));
+	_ASSERTEQUAL(tc::size(setnCopy), 1000);
+	_ASSERT(tc::cont_find<tc::return_bool>(setnCopy, 2997));
+	_ASSERT(!tc::cont_find<tc::return_bool>(setn, 2997));
+}
+
+UNITTESTDEF(flat_hash_set_append) {
+	tc::flat_hash_set<int> setn;
+	tc::append(setn, tc::iota(0, 100));
+	tc::append(setn, tc::iota(100, 200), tc::iota(200, 300));
+	_ASSERTEQUAL(tc::size(setn), 300);
+	_ASSERT(tc::all_of(tc::iota(0, 300), [&](int const n) noexcept { return tc::cont_find<tc::return_bool>(setn, n); }));
+
+	auto const setnConverted = tc::explicit_cast<tc::flat_hash_set<int>>(tc::iota(0, 10));
+	_ASSERTEQUAL(tc::size(setnConverted), 10);
+}
+
+UNITTESTDEF(flat_hash_map) {
+	tc::flat_hash_map<std::string, int> mapstrn;
+	for( int n = 0; n < 200; ++n ) {
+		_ASSERT(mapstrn.try_emplace(std::to_string(n), n).second);
+	}
+	_ASSERT(!tc::cont_try_emplace(mapstrn, std::string("17"), 0).second);
+	_ASSERT(!tc::cont_try_emplace(mapstrn, std::make_pair(std::string("18"), 0)).second);
+	_ASSERTEQUAL(tc::cont_find<tc::return_element>(mapstrn, std::string("17"))->second, 17);
+	_ASSERT(!tc::cont_find<tc::return_element_or_null>(mapstrn, std::string("200")));
+
+	++mapstrn["17"];
+	_ASSERTEQUAL(mapstrn["17"], 18);
+	_ASSERTEQUAL(mapstrn["new"], 0);
+	_ASSERTEQUAL(tc::size(mapstrn), 201);
+
+	_ASSERTEQUAL(mapstrn.erase(std::string("new")), 1);
+	_ASSERTEQUAL(mapstrn.erase(std::string("new")), 0);
+	tc::filter_inplace(mapstrn, [](auto const& pairstrn) noexcept { return pairstrn.second < 100; });
+	_ASSERTEQUAL(tc::size(mapstrn), 100);
+
+	auto mapstrnMoved = tc_move(mapstrn);
+	_ASSERT(tc::empty(mapstrn));
+	_ASSERTEQUAL(tc::size(mapstrnMoved), 100);
+	_ASSERTEQUAL(tc::cont_find<tc::return_element>(mapstrnMoved, std::string("99"))->second, 99);
+}
@@ -0,0 +1,323 @@
+// think-cell public library
+//
+// Copyright (C) 2016-2023 think-cell Software GmbH
+//
+// Distributed under the Boost Software License, Version 1.0.
+// See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt
+
+#pragma once
+
+#include "base/assert_defs.h"
+#include "base/noncopyable.h"
+#include "base/enum.h"
+#include "base/scope.h"
+#include "range/meta.h"
+#include "range/subrange.h"
+#include "algorithm/size.h"
+#include "algorithm/for_each.h"
+#include "algorithm/minmax.h"
+
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <memory>
+
+#ifdef _WIN32
+#pragma push_macro("NOMINMAX")
+#pragma push_macro("WIN32_LEAN_AND_MEAN")
+#ifndef NOMINMAX
+#define NOMINMAX // the min and max macros would break tc::min, std::numeric_limits<T>::max() etc. in every includer
+#endif
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#include <windows.h>
+#pragma pop_macro("WIN32_LEAN_AND_MEAN")
+#pragma pop_macro("NOMINMAX")
+#else
+#include <cerrno>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/uio.h>
+#include <unistd.h>
+#endif
+
+namespace tc {
+	struct file_failure final {};
+
+	namespace no_adl {
+		// Anonymous file opened for reading and writing, which is removed when it is closed.
+		// Data is appended at the end and read back from arbitrary offsets.
+		struct temp_file final : tc::nonmovable {
+			temp_file() MAYTHROW
+				: m_pfile(std::tmpfile())
+			{
+				if( !m_pfile ) throw tc::file_failure();
+			}
+
+			~temp_file() {
+				std::fclose(m_pfile);
+			}
+
+			std::uint64_t size() const& noexcept {
+				return m_nSize;
+			}
+
+			template<tc::contiguous_range Rng>
+			void append(Rng const& rngblob) & MAYTHROW {
+				static_assert(std::is_same<tc::range_value_t<Rng>, unsigned char>::value, "use tc::range_as_blob");
+				auto const nBytes = tc::explicit_cast<std::size_t>(tc::size_raw(rngblob));
+				if( 0 == nBytes ) return;
+				seek(m_nSize); // THROW(tc::file_failure)
+				if( std::fwrite(tc::ptr_begin(rngblob), 1, nBytes, m_pfile) != nBytes ) throw tc::file_failure();
+				m_nSize += nBytes;
+			}
+
+			template<tc::contiguous_range Rng>
+			void read(std::uint64_t const nOffset, Rng&& rngblob) & MAYTHROW {
+				static_assert(std::is_same<tc::range_value_t<Rng>, unsigned char>::value, "use tc::range_as_blob");
+				auto const nBytes = tc::explicit_cast<std::size_t>(tc::size_raw(rngblob));
+				_ASSERT(nOffset + nBytes <= m_nSize);
+				if( 0 == nBytes ) return;
+				seek(nOffset); // THROW(tc::file_failure)
+				if( std::fread(tc::ptr_begin(rngblob), 1, nBytes, m_pfile) != nBytes ) throw tc::file_failure();
+			}
+
+		private:
+			void seek(std::uint64_t const nOffset) & MAYTHROW {
+#ifdef _MSC_VER
+				auto const nResult = _fseeki64(m_pfile, tc::explicit_cast<__int64>(nOffset), SEEK_SET);
+#else
+				auto const nResult = fseeko(m_pfile, tc::explicit_cast<off_t>(nOffset), SEEK_SET);
+#endif
+				if( 0 != nResult ) throw tc::file_failure();
+			}
+
+			std::FILE* const m_pfile;
+			std::uint64_t m_nSize = 0;
+		};
+	}
+	using no_adl::temp_file;
+
+	// Hint to the operating system how a memory-mapped file is going to be read.
+	TC_DEFINE_ENUM(EAccessPattern, eaccesspattern, (NORMAL)(SEQUENTIAL)(RANDOM))
+
+	namespace file_detail {
+		template<typename T>
+		concept byte_like = std::is_trivially_copyable<T>::value && 1 == sizeof(T);
+
+#ifndef _WIN32
+		// Writes all bytes of the buffers with as few system calls as possible, resuming after partial writes.
+		// The iovecs are updated to the bytes not written yet, which are left if an exception is thrown.
+		inline void write_all(int const fd, ::iovec* piov, int niov) MAYTHROW {
+			while( 0 < niov ) {
+				auto const nWritten = ::writev(fd, piov, niov);
+				if( nWritten < 0 ) {
+					if( EINTR == errno ) continue;
+					throw tc::file_failure();
+				}
+				auto n = tc::explicit_cast<std::size_t>(nWritten);
+				for( ; 0 < niov && piov->iov_len <= n; ++piov, --niov ) {
+					n -= piov->iov_len;
+					piov->iov_len = 0;
+				}
+				if( 0 < niov ) {
+					piov->iov_base = static_cast<unsigned char*>(piov->iov_base) + n;
+					piov->iov_len -= n;
+				}
+			}
+		}
+#endif
+	}
+
+	namespace no_adl {
+		// Read-only memory mapping of a whole file, which is a contiguous range of T.
+		template<file_detail::byte_like T = unsigned char>
+		struct [[nodiscard]] mapped_file_range final : tc::nonmovable {
+			explicit mapped_file_range(std::filesystem::path const& path, tc::EAccessPattern const eaccesspattern = tc::eaccesspatternNORMAL) MAYTHROW {
+#ifdef _WIN32
+				DWORD const dwFlags = tc::eaccesspatternSEQUENTIAL == eaccesspattern ? FILE_FLAG_SEQUENTIAL_SCAN
+					: tc::eaccesspatternRANDOM == eaccesspattern ? FILE_FLAG_RANDOM_ACCESS
+					: FILE_ATTRIBUTE_NORMAL;
+				HANDLE const hfile = ::CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, dwFlags, nullptr);
+				if( INVALID_HANDLE_VALUE == hfile ) throw tc::file_failure();
+				tc_scope_exit { ::CloseHandle(hfile); };
+				LARGE_INTEGER nSize;
+				if( !::GetFileSizeEx(hfile, &nSize) ) throw tc::file_failure();
+				m_nSize = tc::explicit_cast<std::size_t>(nSize.QuadPart);
+				if( 0 < m_nSize ) {
+					HANDLE const hmapping = ::CreateFileMappingW(hfile, nullptr, PAGE_READONLY, 0, 0, nullptr);
+					if( !hmapping ) throw tc::file_failure();
+					tc_scope_exit { ::CloseHandle(hmapping); }; // the view keeps the mapping alive
+					m_pt = static_cast<T const*>(::MapViewOfFile(hmapping, FILE_MAP_READ, 0, 0, 0));
+					if( !m_pt ) throw tc::file_failure();
+				}
+#else
+				int const fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+				if( fd < 0 ) throw tc::file_failure();
+				tc_scope_exit { ::close(fd); }; // the mapping stays valid after closing the file
+				struct ::stat st;
+				if( 0 != ::fstat(fd, &st) ) throw tc::file_failure();
+				m_nSize = tc::explicit_cast<std::size_t>(st.st_size);
+				if( 0 < m_nSize ) { // mmap fails for empty files
+					void* const pv = ::mmap(nullptr, m_nSize, PROT_READ, MAP_PRIVATE, fd, 0);
+					if( MAP_FAILED == pv ) throw tc::file_failure();
+					m_pt = static_cast<T const*>(pv);
+					advise(eaccesspattern);
+				}
+#endif
+			}
+
+			~mapped_file_range() {
+				if( m_pt ) {
+#ifdef _WIN32
+					::UnmapViewOfFile(m_pt);
+#else
+					::munmap(const_cast<T*>(m_pt), m_nSize);
+#endif
+				}
+			}
+
+			// Changes the hint how the remainder of the file is read. Windows only takes the hint when the file is opened.
+			void advise([[maybe_unused]] tc::EAccessPattern const eaccesspattern) const& noexcept {
+#ifndef _WIN32
+				if( m_pt ) {
+					::madvise(const_cast<T*>(m_pt), m_nSize,
+						tc::eaccesspatternSEQUENTIAL == eaccesspattern ? MADV_SEQUENTIAL
+						: tc::eaccesspatternRANDOM == eaccesspattern ? MADV_RANDOM
+						: MADV_NORMAL
+					); // only a hint, errors do not matter
+				}
+#endif
+			}
+
+			T const* begin() const& noexcept { return m_pt; }
+			T const* end() const& noexcept { return m_pt + m_nSize; }
+			T const* data() const& noexcept { return m_pt; }
+			std::size_t size() const& noexcept { return m_nSize; }
+
+			using iterator = T const*;
+			using const_iterator = T const*;
+
+		private:
+			T const* m_pt = nullptr;
+			std::size_t m_nSize = 0;
+		};
+
+		// File opened for writing, which is truncated if it exists. tc::append(filesink, rng) and tc::for_each(rng, tc::appender(filesink))
+		// write ranges of bytes or chars. Output is buffered, and large contiguous chunks are written together with the buffer by a single writev.
+		struct [[nodiscard]] file_sink final : tc::nonmovable {
+			explicit file_sink(std::filesystem::path const& path) MAYTHROW
+				: m_pbBuffer(std::make_unique<unsigned char[]>(c_nBufferSize))
+			{
+#ifdef _WIN32
+				m_hfile = ::CreateFileW(path.c_str(), GENERIC_WRITE, 0, nullptr, CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+				if( INVALID_HANDLE_VALUE == m_hfile ) throw tc::file_failure();
+#else
+				m_fd = ::open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0666);
+				if( m_fd < 0 ) throw tc::file_failure();
+#endif
+			}
+
+			// Call flush() before to observe write errors, they are ignored here.
+			~file_sink() {
+				try {
+					flush(); // THROW(tc::file_failure)
+				} catch( tc::file_failure const& ) {
+				}
+#ifdef _WIN32
+				::CloseHandle(m_hfile);
+#else
+				::close(m_fd);
+#endif
+			}
+
+			void flush() & MAYTHROW {
+				write(nullptr, 0); // THROW(tc::file_failure)
+			}
+
+			struct [[nodiscard]] appender final {
+				using guaranteed_break_or_continue = tc::constant<tc::continue_>;
+				file_sink& m_filesink;
+
+				template<file_detail::byte_like T>
+				void operator()(T const& t) const& MAYTHROW {
+					if( c_nBufferSize == m_filesink.m_nBuffered ) {
+						m_filesink.flush(); // THROW(tc::file_failure)
+					}
+					std::memcpy(m_filesink.m_pbBuffer.get() + m_filesink.m_nBuffered, std::addressof(t), 1);
+					++m_filesink.m_nBuffered;
+				}
+
+				template<tc::contiguous_range Rng> requires file_detail::byte_like<tc::range_value_t<Rng>>
+				void chunk(Rng const& rng) const& MAYTHROW {
+					m_filesink.write(tc::ptr_begin(rng), tc::explicit_cast<std::size_t>(tc::ptr_end(rng) - tc::ptr_begin(rng))); // THROW(tc::file_failure)
+				}
+			};
+
+			friend appender appender_impl(file_sink& filesink) noexcept {
+				return {filesink};
+			}
+
+		private:
+			static constexpr std::size_t c_nBufferSize = 1 << 16;
+
+			// Appends n bytes at pv to the buffer, or writes the buffer followed by them if they do not fit.
+			void write(void const* const pv, std::size_t const n) & MAYTHROW {
+				if( 0 < n && n <= c_nBufferSize - m_nBuffered ) {
+					std::memcpy(m_pbBuffer.get() + m_nBuffered, pv, n);
+					m_nBuffered += n;
+				} else if( 0 < m_nBuffered || 0 < n ) {
+					// If writing fails, keep only the bytes of the buffer that have not been written, so that they are not written twice by the next flush.
+					auto const KeepUnwritten = [&](void const* const pvUnwritten, std::size_t const nUnwritten) noexcept {
+						std::memmove(m_pbBuffer.get(), pvUnwritten, nUnwritten);
+						m_nBuffered = nUnwritten;
+					};
+#ifdef _WIN32
+					auto const WriteAll = [&](void const*& pv, std::size_t& n) MAYTHROW {
+						while( 0 < n ) {
+							DWORD nWritten;
+							if( !::WriteFile(m_hfile, pv, tc::explicit_cast<DWORD>(tc::min(n, std::size_t(1) << 30)), &nWritten, nullptr) ) throw tc::file_failure();
+							pv = static_cast<unsigned char const*>(pv) + nWritten;
+							n -= nWritten;
+						}
+					};
+					void const* pvBuffer = m_pbBuffer.get();
+					std::size_t nBuffer = m_nBuffered;
+					try {
+						WriteAll(pvBuffer, nBuffer); // THROW(tc::file_failure)
+					} catch( tc::file_failure const& ) {
+						KeepUnwritten(pvBuffer, nBuffer);
+						throw;
+					}
+					m_nBuffered = 0;
+					void const* pvChunk = pv;
+					std::size_t nChunk = n;
+					WriteAll(pvChunk, nChunk); // THROW(tc::file_failure)
+#else
+					::iovec aiov[2] = {{m_pbBuffer.get(), m_nBuffered}, {const_cast<void*>(pv), n}};
+					try {
+						file_detail::write_all(m_fd, aiov, 2); // THROW(tc::file_failure)
+					} catch( tc::file_failure const& ) {
+						KeepUnwritten(aiov[0].iov_base, aiov[0].iov_len);
+						throw;
+					}
+					m_nBuffered = 0;
+#endif
+				}
+			}
+
+			std::unique_ptr<unsigned char[]> m_pbBuffer;
+			std::size_t m_nBuffered = 0;
+#ifdef _WIN32
+			HANDLE m_hfile;
+#else
+			int m_fd;
+#endif
+		};
+	}
+	using no_adl::mapped_file_range;
+	using no_adl::file_sink;
+}
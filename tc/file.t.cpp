@@ -0,0 +1,48 @@
+// think-cell public library
+//
+// Copyright (C) 2016-2023 think-cell Software GmbH
+//
+// Distributed under the Boost Software License, Version 1.0.
+// See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt
+
+#include "base/assert_defs.h"
+#include "unittest.h"
+#include "file.h"
+#include "algorithm/append.h"
+#include "range/transform.h"
+#include "range/iota_range.h"
+#include "string/format.h"
+
+#include <filesystem>
+
+UNITTESTDEF(file_sink_and_mapped_file_range) {
+	auto const path = std::filesystem::temp_directory_path() / "tc_file_sink_test.txt";
+	auto const strLarge = tc::make_str<char>(tc::transform(tc::iota(0, 100000), [](int const n) noexcept { return static_cast<char>('a' + n % 26); }));
+	{
+		tc::file_sink filesink(path);
+		tc::append(filesink, tc::format<"{}, {}\n">("line", tc::as_dec(1)));
+		tc::append(filesink, strLarge); // larger than the buffer
+		tc::for_each(tc::iota(0, 3), [&](int const n) MAYTHROW { tc::append(filesink, tc::as_dec(n)); });
+		filesink.flush();
+	}
+	{
+		tc::mapped_file_range<char> file(path, tc::eaccesspatternSEQUENTIAL);
+		_ASSERT(tc::equal(file, tc::concat("line, 1\n", strLarge, "012")));
+		file.advise(tc::eaccesspatternRANDOM);
+		_ASSERTEQUAL(tc::at(file, 8), 'a');
+	}
+	{
+		tc::file_sink filesink(path); // truncates
+	}
+	{
+		tc::mapped_file_range<> file(path);
+		_ASSERT(tc::empty(file));
+	}
+	std::filesystem::remove(path);
+
+	try {
+		tc::mapped_file_range<> file(path);
+		_ASSERTFALSE;
+	} catch( tc::file_failure const& ) {
+	}
+}
@@ -17,6 +17,7 @@
 #include "algorithm/algorithm.h"
 #include "container/container.h" 
 #include "range/iota_range.h"
+#include "range/filter_adaptor.h"
 #include "interval_types.h"
 #include "dense_map.h"
 
@@ -869,46 +870,50 @@ MODIFY_WARNINGS(((suppress)(4552))) // '-': operator has no effect; expected ope
 			using const_iterator = tc::iterator_t<tc::vector<T> const>;
 			using base_ = tc::vector< T >;
 	
-			iterator lower_bound(T const& t) & noexcept {
-				return tc::lower_bound<tc::return_border>(*this, t, _Pr());
+			// like std::set with transparent comparator, keys other than T are compared by _Pr, too
+			template<typename K>
+			iterator lower_bound(K const& k) & noexcept {
+				return tc::lower_bound<tc::return_border>(*this, k, _Pr());
 			}
 
-			const_iterator lower_bound(T const& t) const& noexcept {
-				return tc::lower_bound<tc::return_border>(*this, t, _Pr());
+			template<typename K>
+			const_iterator lower_bound(K const& k) const& noexcept {
+				return tc::lower_bound<tc::return_border>(*this, k, _Pr());
 			}
 
-			iterator upper_bound(T const& t) & noexcept {
-				return tc::upper_bound<tc::return_border>(*this, t, _Pr());
+			template<typename K>
+			iterator upper_bound(K const& k) & noexcept {
+				return tc::upper_bound<tc::return_border>(*this, k, _Pr());
 			}
 
-			const_iterator upper_bound(T const& t) const& noexcept {
-				return tc::upper_bound<tc::return_border>(*this, t, _Pr());
+			template<typename K>
+			const_iterator upper_bound(K const& k) const& noexcept {
+				return tc::upper_bound<tc::return_border>(*this, k, _Pr());
 			}
 
-			template< typename A0 >
-			iterator emplace_hint(iterator& itWhere, A0&& a0) & noexcept {
-				iterator it = base_::emplace(itWhere, std::forward<A0>(a0) );
-				itWhere = it;
-				++itWhere;
-				return it;
-			}
-
-			template< typename A0, typename A1 >
-			iterator emplace_hint(iterator& itWhere, A0&& a0, A1&& a1) & noexcept {
-				iterator it = tc::vector< T >::emplace(itWhere, std::forward<A0>(a0), std::forward<A1>(a1) );
-				itWhere = it;
-				++itWhere;
-				return it;
+			template< typename... Args >
+			iterator emplace_hint(const_iterator itWhere, Args&&... args) & noexcept {
+				return base_::emplace(itWhere, std::forward<Args>(args)...);
 			}
 		};
 	}
 
+	namespace interval_set_detail {
+		// any range of intervals, in any order, possibly overlapping
+		template<typename RngIntvl, typename TInterval>
+		concept unordered_intervals =
+			std::convertible_to<tc::range_value_t<RngIntvl>, TInterval> &&
+			!tc::instance<std::remove_cvref_t<RngIntvl>, tc::interval_set>;
+	}
+
 	namespace interval_set_adl {
 		template<typename T, typename TInterval, typename SetOrVectorImpl>
 		struct interval_set :
 			tc::setlike<>
 		{
 		private:
+			template<typename, typename, typename> friend struct interval_set;
+
 			using Cont=std::conditional_t<
 				std::is_same< SetOrVectorImpl, use_set_impl_tag_t >::value,
 				tc::set< TInterval, tc::no_adl::less_begin< T, TInterval > >,
@@ -916,6 +921,16 @@ MODIFY_WARNINGS(((suppress)(4552))) // '-': operator has no effect; expected ope
 			>;
 			Cont m_cont;
 
+			// tc::cont_must_emplace_before checks the position of the new element by the hint, which a vector invalidates
+			template<typename... Args>
+			static auto emplace_before(Cont& cont, tc::iterator_t<Cont const> itHint, Args&&... args) noexcept {
+				if constexpr( std::is_same<SetOrVectorImpl, use_vector_impl_tag_t>::value ) {
+					return cont.emplace_hint(itHint, std::forward<Args>(args)...);
+				} else {
+					return tc::cont_must_emplace_before(cont, itHint, std::forward<Args>(args)...);
+				}
+			}
+
 		public:
 			using const_iterator = tc::iterator_t<Cont const>;
 	
@@ -931,6 +946,23 @@ MODIFY_WARNINGS(((suppress)(4552))) // '-': operator has no effect; expected ope
 				: m_cont( itBegin, itEnd )
 			{}
 
+			// Sorts the intervals once and merges overlapping and touching ones in a single pass, instead of inserting them one by one.
+			template<typename RngIntvl> requires interval_set_detail::unordered_intervals<RngIntvl, TInterval>
+			explicit interval_set(RngIntvl&& rngintvl) noexcept {
+				auto vecintvl = tc::make_vector(tc::filter(std::forward<RngIntvl>(rngintvl), [](TInterval const& intvl) noexcept { return !intvl.empty(); }));
+				tc::sort_inplace(vecintvl, tc::no_adl::less_begin<T, TInterval>());
+				if constexpr( std::is_same<SetOrVectorImpl, use_vector_impl_tag_t>::value ) {
+					tc::cont_reserve(m_cont, tc::size(vecintvl));
+				}
+				tc::for_each(vecintvl, [&](TInterval const& intvl) noexcept {
+					if (!tc::empty(m_cont) && !(tc::back(m_cont)[tc::hi] < intvl[tc::lo])) {
+						tc::assign_max(tc::as_mutable(tc::back(m_cont))[tc::hi], intvl[tc::hi]);
+					} else {
+						emplace_before(m_cont, tc::end(m_cont), intvl);
+					}
+				});
+			}
+
 			const_iterator begin() const& noexcept {
 				return tc::begin(m_cont);
 			}
@@ -948,78 +980,85 @@ MODIFY_WARNINGS(((suppress)(4552))) // '-': operator has no effect; expected ope
 				return TInterval(tc::front(*this)[tc::lo], tc::back(*this)[tc::hi]);
 			}
 
+			// Intervals overlapping or touching interval are merged into the first one of them, and the others are erased at once,
+			// so with use_vector_impl_tag_t, the following intervals are moved at most once.
 			interval_set& operator|=(TInterval const& interval) & noexcept {
 				if (!interval.empty()) {
-					auto itinterval = m_cont.upper_bound(interval);
-
-					tc::iterator_t<Cont> itintervalAdd;
-
-					if (itinterval != tc::begin(m_cont)) {
-						itintervalAdd = itinterval;
-						--itintervalAdd;
-						if ((*itintervalAdd)[tc::hi] < interval[tc::lo]) {
-							itintervalAdd = m_cont.emplace_hint(itinterval, interval);
-						} else if (!((*itintervalAdd)[tc::hi] < interval[tc::hi])) {
-							return *this;
-						}
-					} else {
-						itintervalAdd = m_cont.emplace_hint(itinterval, interval);
-					}
-
-					for (; itinterval != tc::end(m_cont) && !(interval[tc::hi] < (*itinterval)[tc::hi]); ) {
-						itinterval = m_cont.erase(itinterval);
+					auto itintervalBegin = m_cont.upper_bound(interval[tc::lo]);
+					auto itintervalEnd = m_cont.upper_bound(interval[tc::hi]);
+					if (itintervalBegin != tc::begin(m_cont) && !((*tc_modified(itintervalBegin, --_))[tc::hi] < interval[tc::lo])) {
+						--itintervalBegin;
 					}
 
-					if (itinterval != tc::end(m_cont) && !(interval[tc::hi] < (*itinterval)[tc::lo])) {
-						tc::as_mutable(*itintervalAdd)[tc::hi] = (*itinterval)[tc::hi];
-						m_cont.erase(itinterval);
+					if (itintervalBegin == itintervalEnd) {
+						emplace_before(m_cont, itintervalEnd, interval);
 					} else {
-						tc::as_mutable(*itintervalAdd)[tc::hi] = interval[tc::hi];
+						auto& intervalMerged = tc::as_mutable(*itintervalBegin);
+						tc::assign_min(intervalMerged[tc::lo], interval[tc::lo]);
+						intervalMerged[tc::hi] = tc::max(interval[tc::hi], (*tc_modified(itintervalEnd, --_))[tc::hi]);
+						m_cont.erase(tc_modified(itintervalBegin, ++_), itintervalEnd);
 					}
 				}
 				return *this;
 			}
 
+			// Like operator|=, intervals partially overlapping interval are shortened, and the ones inside are erased at once.
 			interval_set& operator-=(TInterval const& interval) & noexcept {
 				if (!interval.empty()) {
-					auto itinterval = m_cont.lower_bound(interval);
-
-					if (itinterval != tc::begin(m_cont)) {
-						auto itintervalOverlap = itinterval;
-						--itintervalOverlap;
-						if (interval[tc::lo] < (*itintervalOverlap)[tc::hi]) {
-							if (interval[tc::hi] < (*itintervalOverlap)[tc::hi]) {
-								TInterval intervalRemainder(interval[tc::hi], (*itintervalOverlap)[tc::hi]);
-								tc::as_mutable(*itintervalOverlap)[tc::hi] = interval[tc::lo];
-								m_cont.emplace_hint(itinterval, intervalRemainder);
+					auto itintervalBegin = m_cont.upper_bound(interval[tc::lo]);
+					auto itintervalEnd = m_cont.lower_bound(interval[tc::hi]);
+					if (itintervalBegin != tc::begin(m_cont) && interval[tc::lo] < (*tc_modified(itintervalBegin, --_))[tc::hi]) {
+						--itintervalBegin;
+					}
+
+					if (itintervalBegin != itintervalEnd) {
+						auto const itintervalLast = tc_modified(itintervalEnd, --_);
+						T const tHiLast = (*itintervalLast)[tc::hi];
+						if ((*itintervalBegin)[tc::lo] < interval[tc::lo]) {
+							tc::as_mutable(*itintervalBegin)[tc::hi] = interval[tc::lo];
+							++itintervalBegin;
+						}
+						if (interval[tc::hi] < tHiLast) {
+							if (itintervalBegin == itintervalEnd) { // interval splits a single interval
+								emplace_before(m_cont, itintervalEnd, interval[tc::hi], tHiLast);
 								return *this;
-							} else {
-								tc::as_mutable(*itintervalOverlap)[tc::hi] = interval[tc::lo];
 							}
+							tc::as_mutable(*itintervalLast)[tc::lo] = interval[tc::hi];
+							itintervalEnd = itintervalLast;
 						}
-					}
-
-					while (itinterval != tc::end(m_cont) && !(interval[tc::hi] < (*itinterval)[tc::hi])) {
-						itinterval = m_cont.erase(itinterval);
-					}
-
-					if (itinterval != tc::end(m_cont) && (*itinterval)[tc::lo] < interval[tc::hi]) {
-						TInterval intervalInsert(interval[tc::hi], (*itinterval)[tc::hi]);
-						_ASSERT(!intervalInsert.empty());
-						itinterval = m_cont.erase(itinterval);
-						m_cont.emplace_hint(itinterval, intervalInsert);
+						m_cont.erase(itintervalBegin, itintervalEnd);
 					}
 				}
 				return *this;
 			}
 
-			interval_set& operator-=(interval_set const& intvlset) & noexcept {
-				tc::for_each(intvlset.m_cont, [this]( TInterval const& intvl ) noexcept {
-					*this-=intvl;
+			template<typename OtherSetOrVectorImpl>
+			interval_set& operator-=(interval_set<T, TInterval, OtherSetOrVectorImpl> const& intvlset) & noexcept {
+				Cont cont;
+				auto itintervalB = tc::begin(intvlset.m_cont);
+				tc::for_each(m_cont, [&](TInterval intvl) noexcept {
+					// intervals of intvlset ending before intvl end before all following intervals, too
+					while (itintervalB != tc::end(intvlset.m_cont) && !(intvl[tc::lo] < (*itintervalB)[tc::hi])) {
+						++itintervalB;
+					}
+					for (auto itinterval = itintervalB; itinterval != tc::end(intvlset.m_cont) && (*itinterval)[tc::lo] < intvl[tc::hi]; ++itinterval) {
+						if (intvl[tc::lo] < (*itinterval)[tc::lo]) {
+							emplace_before(cont, tc::end(cont), intvl[tc::lo], (*itinterval)[tc::lo]);
+						}
+						intvl[tc::lo] = (*itinterval)[tc::hi];
+						if (intvl.empty()) return;
+					}
+					emplace_before(cont, tc::end(cont), intvl);
 				});
+				m_cont = tc_move(cont);
 				return *this;
 			}
 
+			template<typename RngIntvl> requires interval_set_detail::unordered_intervals<RngIntvl, TInterval>
+			interval_set& operator-=(RngIntvl&& rngintvl) & noexcept {
+				return *this -= interval_set(std::forward<RngIntvl>(rngintvl));
+			}
+
 			void erase(T const& t) & noexcept {
 				erase(TInterval(t, tc_modified(t, ++_)));
 			}
@@ -1054,7 +1093,7 @@ MODIFY_WARNINGS(((suppress)(4552))) // '-': operator has no effect; expected ope
 					auto itintervalPartial=itinterval;
 					--itintervalPartial;
 					if( t < (*itintervalPartial)[tc::hi] ) {
-						itinterval=tc::cont_must_emplace_before( m_cont, itinterval, t, (*itintervalPartial)[tc::hi] );
+						itinterval=emplace_before( m_cont, itinterval, t, (*itintervalPartial)[tc::hi] );
 					}
 				}
 				m_cont.erase( tc::begin(m_cont), itinterval );
@@ -1246,23 +1285,24 @@ MODIFY_WARNINGS(((suppress)(4552))) // '-': operator has no effect; expected ope
 					++itinterval;
 
 					TInterval intvl( tc::all_values_interval<T>[tc::lo], (*itintervalPrevious)[tc::lo] );
-					if(!intvl.empty()) tc::cont_must_emplace_before( intvlset.m_cont, tc::end(intvlset.m_cont), intvl );
+					if(!intvl.empty()) emplace_before( intvlset.m_cont, tc::end(intvlset.m_cont), intvl );
 			
 					for(; itinterval!=end(); ++itinterval) {
 						intvl=TInterval( (*itintervalPrevious)[tc::hi], (*itinterval)[tc::lo] );
 						_ASSERT(!intvl.empty());
-						tc::cont_must_emplace_before( intvlset.m_cont, tc::end(intvlset.m_cont), intvl );
+						emplace_before( intvlset.m_cont, tc::end(intvlset.m_cont), intvl );
 				
 						itintervalPrevious=itinterval;
 					}
 
 					intvl=TInterval( (*itintervalPrevious)[tc::hi], tc::all_values_interval<T>[tc::hi] );
-					if(!intvl.empty()) tc::cont_must_emplace_before( intvlset.m_cont, tc::end(intvlset.m_cont), intvl );
+					if(!intvl.empty()) emplace_before( intvlset.m_cont, tc::end(intvlset.m_cont), intvl );
 				}
 				return intvlset;
 			}
 
-			interval_set& operator|=( interval_set<T, TInterval, SetOrVectorImpl> const& intvlset) & noexcept {
+			template<typename OtherSetOrVectorImpl>
+			interval_set& operator|=( interval_set<T, TInterval, OtherSetOrVectorImpl> const& intvlset) & noexcept {
 				Cont cont;
 
 				auto itintervalA = tc::begin(m_cont);
@@ -1292,11 +1332,11 @@ MODIFY_WARNINGS(((suppress)(4552))) // '-': operator has no effect; expected ope
 					}
 
 		end_from_A:
-					tc::cont_must_emplace_before( cont, tc::end(cont), tc::make_interval( tIntervalBegin, (*itintervalA)[tc::hi] ) );
+					emplace_before( cont, tc::end(cont), tc::make_interval( tIntervalBegin, (*itintervalA)[tc::hi] ) );
 					++itintervalA;
 					continue;
 		end_from_B:
-					tc::cont_must_emplace_before( cont, tc::end(cont), tc::make_interval( tIntervalBegin, (*itintervalB)[tc::hi] ) );
+					emplace_before( cont, tc::end(cont), tc::make_interval( tIntervalBegin, (*itintervalB)[tc::hi] ) );
 					++itintervalB;
 					continue;
 				}
@@ -1304,6 +1344,11 @@ MODIFY_WARNINGS(((suppress)(4552))) // '-': operator has no effect; expected ope
 				return *this;
 			}
 
+			template<typename RngIntvl> requires interval_set_detail::unordered_intervals<RngIntvl, TInterval>
+			interval_set& operator|=(RngIntvl&& rngintvl) & noexcept {
+				return *this |= interval_set(std::forward<RngIntvl>(rngintvl));
+			}
+
 			auto all_intervals() const& noexcept -> Cont const& {
 				return m_cont;
 			}
@@ -1315,7 +1360,7 @@ MODIFY_WARNINGS(((suppress)(4552))) // '-': operator has no effect; expected ope
 			> {
 				if(!empty() && !intvlset.empty()) {
 					const_iterator itintervalA = tc::begin(m_cont);
-					const_iterator itintervalB = tc::begin(intvlset.m_cont);
+					auto itintervalB = tc::begin(intvlset.m_cont);
 					if((*itintervalA)[tc::lo]<(*itintervalB)[tc::lo]) {
 						itintervalA=m_cont.upper_bound( *itintervalB );
 						--itintervalA;
@@ -1356,12 +1401,17 @@ MODIFY_WARNINGS(((suppress)(4552))) // '-': operator has no effect; expected ope
 				Cont contIntersection;
 				for_each_intersecting_interval(intvlset, 
 					[&]( tc::unused, tc::unused, TInterval const& intvl ) noexcept {
-						tc::cont_must_emplace_before( contIntersection, tc::end(contIntersection),intvl);
+						emplace_before( contIntersection, tc::end(contIntersection),intvl);
 					});
 				m_cont=tc_move(contIntersection);
 				return *this;
 			}
 
+			template<typename RngIntvl> requires interval_set_detail::unordered_intervals<RngIntvl, TInterval>
+			interval_set& operator&=(RngIntvl&& rngintvl) & noexcept {
+				return *this &= interval_set(std::forward<RngIntvl>(rngintvl));
+			}
+
 			friend void swap( interval_set& lhs, interval_set& rhs ) noexcept {
 				tc::swap( lhs.m_cont, rhs.m_cont );
 			}
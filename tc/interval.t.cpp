@@ -208,3 +208,92 @@ UNITTESTDEF(linear_interval_transform) {
 	Test(-1.0, 1.0, -1.0, -2.0, std::make_pair(-0.5, -1.25), std::make_pair(0.0, -1.5), std::make_pair(0.5, -1.75), std::make_pair(2.0, -2.5), std::make_pair(3.0, -3));
 	Test(1e-20, 1e20, 1e30, -1e-20);
 }
+
+namespace {
+	constexpr int c_nUniverse = 100;
+
+	template<typename IntervalSet>
+	std::array<bool, c_nUniverse> membership(IntervalSet const& intvlset) noexcept {
+		std::array<bool, c_nUniverse> abMember{};
+		std::optional<int> onHiPrev;
+		tc::for_each(intvlset, [&](tc::interval<int> const& intvl) noexcept {
+			// intervals are sorted, not empty and neither overlap nor touch
+			_ASSERT(!intvl.empty());
+			_ASSERT(!onHiPrev || *onHiPrev < intvl[tc::lo]);
+			onHiPrev = intvl[tc::hi];
+			for( int n = intvl[tc::lo]; n < intvl[tc::hi]; ++n ) tc::at(abMember, n) = true;
+		});
+		return abMember;
+	}
+
+	tc::vector<tc::interval<int>> random_intervals(unsigned int& nSeed, int const nCount) noexcept {
+		tc::vector<tc::interval<int>> vecintvl;
+		for( int i = 0; i < nCount; ++i ) {
+			nSeed = nSeed * 1103515245u + 12345u;
+			int const nLo = tc::explicit_cast<int>(nSeed >> 8) % c_nUniverse;
+			int const nLength = tc::explicit_cast<int>(nSeed >> 20) % 12 - 1; // some are empty
+			tc::cont_emplace_back(vecintvl, nLo, tc::min(nLo + nLength, c_nUniverse));
+		}
+		return vecintvl;
+	}
+
+	template<typename SetOrVectorImpl, typename OtherSetOrVectorImpl>
+	void test_interval_set_operations() noexcept {
+		using interval_set = tc::interval_set<int, tc::interval<int>, SetOrVectorImpl>;
+		using other_interval_set = tc::interval_set<int, tc::interval<int>, OtherSetOrVectorImpl>;
+		unsigned int nSeed = 1;
+		for( int nIteration = 0; nIteration < 200; ++nIteration ) {
+			auto const vecintvlA = random_intervals(nSeed, nIteration % 20);
+			auto const vecintvlB = random_intervals(nSeed, nIteration % 7);
+
+			std::array<bool, c_nUniverse> abA{};
+			interval_set intvlsetA;
+			tc::for_each(vecintvlA, [&](tc::interval<int> const& intvl) noexcept {
+				for( int n = intvl[tc::lo]; n < intvl[tc::hi]; ++n ) tc::at(abA, n) = true;
+				intvlsetA |= intvl;
+			});
+			_ASSERT(membership(intvlsetA) == abA);
+			_ASSERT(membership(interval_set(vecintvlA)) == abA);
+
+			std::array<bool, c_nUniverse> abB{};
+			other_interval_set intvlsetB(vecintvlB);
+			tc::for_each(vecintvlB, [&](tc::interval<int> const& intvl) noexcept {
+				for( int n = intvl[tc::lo]; n < intvl[tc::hi]; ++n ) tc::at(abB, n) = true;
+			});
+			_ASSERT(membership(intvlsetB) == abB);
+
+			auto const ComputeExpected = [&](auto fn) noexcept {
+				std::array<bool, c_nUniverse> ab;
+				for( int n = 0; n < c_nUniverse; ++n ) tc::at(ab, n) = fn(tc::at(abA, n), tc::at(abB, n));
+				return ab;
+			};
+			auto const abUnion = ComputeExpected([](bool const bA, bool const bB) noexcept { return bA || bB; });
+			auto const abDifference = ComputeExpected([](bool const bA, bool const bB) noexcept { return bA && !bB; });
+			auto const abIntersection = ComputeExpected([](bool const bA, bool const bB) noexcept { return bA && bB; });
+
+			_ASSERT(membership(tc_modified(intvlsetA, _ |= intvlsetB)) == abUnion);
+			_ASSERT(membership(tc_modified(intvlsetA, _ |= vecintvlB)) == abUnion);
+			_ASSERT(membership(tc_modified(intvlsetA, _ -= intvlsetB)) == abDifference);
+			_ASSERT(membership(tc_modified(intvlsetA, _ -= vecintvlB)) == abDifference);
+			_ASSERT(membership(tc_modified(intvlsetA, _ &= intvlsetB)) == abIntersection);
+			_ASSERT(membership(tc_modified(intvlsetA, _ &= vecintvlB)) == abIntersection);
+			_ASSERT(membership(tc_modified(intvlsetA, tc::for_each(vecintvlB, [&](tc::interval<int> const& intvl) noexcept { _ -= intvl; }))) == abDifference);
+		}
+	}
+}
+
+UNITTESTDEF(interval_set_operations) {
+	test_interval_set_operations<tc::use_set_impl_tag_t, tc::use_set_impl_tag_t>();
+	test_interval_set_operations<tc::use_vector_impl_tag_t, tc::use_vector_impl_tag_t>();
+	test_interval_set_operations<tc::use_set_impl_tag_t, tc::use_vector_impl_tag_t>();
+	test_interval_set_operations<tc::use_vector_impl_tag_t, tc::use_set_impl_tag_t>();
+
+	tc::interval_set<int, tc::interval<int>, tc::use_vector_impl_tag_t> intvlset(tc::vector<tc::interval<int>>{{5, 7}, {0, 2}, {1, 3}, {3, 4}, {9, 9}});
+	_ASSERT(tc::equal(intvlset, (tc::vector<tc::interval<int>>{{0, 4}, {5, 7}})));
+	intvlset -= tc::make_interval(1, 2);
+	_ASSERT(tc::equal(intvlset, (tc::vector<tc::interval<int>>{{0, 1}, {2, 4}, {5, 7}})));
+	intvlset |= tc::make_interval(1, 5);
+	_ASSERT(tc::equal(intvlset, (tc::vector<tc::interval<int>>{{0, 7}})));
+	_ASSERT(intvlset.contains(6));
+	_ASSERT(!intvlset.contains(7));
+}
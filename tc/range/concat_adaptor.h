@@ -115,6 +115,14 @@ namespace tc {
 					);
 			}
 
+			constexpr tc::size_bounds size_hint() const& MAYTHROW {
+				return tc::accumulate(
+					m_tupleadaptbaserng,
+					tc::size_bounds{0, std::size_t(0)},
+					[](tc::size_bounds& bounds, auto const& adaptbaserng) MAYTHROW { bounds = bounds + tc::size_hint(adaptbaserng.base_range()); } // MAYTHROW
+				);
+			}
+
 			constexpr bool empty() const& noexcept {
 				return tc::all_of(m_tupleadaptbaserng, [](auto const& adaptbaserng) noexcept { return tc::empty(adaptbaserng.base_range()); });
 			}
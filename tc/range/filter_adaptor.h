@@ -12,8 +12,10 @@
 #include "../base/tc_move.h" 
 #include "../base/conditional.h"
 #include "../base/invoke.h"
+#include "../algorithm/size.h"
 
 #include "range_adaptor.h"
+#include "subrange.h"
 #include "meta.h"
 #include "range_fwd.h"
 
@@ -36,6 +38,36 @@ namespace tc {
 					? tc::continue_if_not_break(m_sink, std::forward<T>(t))
 					: tc::constant<tc::continue_>()
 			)
+
+		private:
+			template<typename Value>
+			static constexpr std::size_t c_nStagingSize = 1024 / sizeof(Value);
+
+			template<typename Value>
+			using staged_chunk_t = decltype(tc::make_iterator_range(std::declval<Value const*>(), std::declval<Value const*>()));
+
+		public:
+			// Copy kept elements of a chunk into a bounded stack buffer and pass them on as contiguous chunks,
+			// so that the sink can insert in bulk. Only done for small trivial types, for which the extra copy is cheap,
+			// and for sinks that never break, which otherwise would see the predicate evaluated beyond the element they break at.
+			template<typename Rng, typename Value = tc::range_value_t<Rng>>
+				requires std::is_trivial<Value>::value && (16 <= c_nStagingSize<Value>) && tc::has_mem_fn_chunk<Sink const&, staged_chunk_t<Value>> &&
+					std::is_same<tc::constant<tc::continue_>, decltype(tc::continue_if_not_break(tc::mem_fn_chunk(), std::declval<Sink const&>(), std::declval<staged_chunk_t<Value>>()))>::value
+			tc::constant<tc::continue_> chunk(Rng&& rng) const& MAYTHROW {
+				Value aval[c_nStagingSize<Value>]; // uninitialized
+				std::size_t nStaged = 0;
+				auto const Flush = [&]() MAYTHROW {
+					tc::continue_if_not_break(tc::mem_fn_chunk(), m_sink, tc::make_iterator_range(tc::implicit_cast<Value const*>(aval), tc::implicit_cast<Value const*>(aval + std::exchange(nStaged, 0)))); // MAYTHROW
+				};
+				tc::for_each(std::forward<Rng>(rng), [&](auto&& t) MAYTHROW {
+					if( tc::explicit_cast<bool>(tc::invoke(m_pred, tc::as_const(t))) ) {
+						aval[nStaged] = t;
+						if( c_nStagingSize<Value> == ++nStaged ) Flush(); // MAYTHROW
+					}
+				});
+				if( 0 < nStaged ) Flush(); // MAYTHROW
+				return tc::constant<tc::continue_>();
+			}
 		};
 
 		template< typename Pred, typename Rng >
@@ -56,6 +88,10 @@ namespace tc {
 			constexpr auto adapted_sink(Sink&& sink, bool /*bReverse*/) const& noexcept {
 				return filter_sink<Pred, tc::decay_t<Sink>>{m_pred, std::forward<Sink>(sink)};
 			}
+
+			constexpr tc::size_bounds size_hint() const& MAYTHROW {
+				return tc::size_hint(this->base_range()).subset();
+			}
 		};
 
 		template< typename Pred, typename Rng >
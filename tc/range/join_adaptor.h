@@ -95,6 +95,19 @@ namespace tc {
 				tc::accumulate(tc::transform(SFINAE_VALUE(this)->base_range(), tc::fn_size_linear_raw(), tc::explicit_cast<std::size_t>(0), tc::fn_assign_plus()))
 			)
 
+			// Sum of the hints of the inner ranges. Only if the outer range refers to stored inner ranges, which are not created
+			// again when the outer range is iterated, as they would be for a tc::transform.
+			constexpr tc::size_bounds size_hint() const& MAYTHROW requires
+				tc::range_with_iterators<std::remove_reference_t<RngRng> const> &&
+				std::is_lvalue_reference<std::iter_reference_t<tc::iterator_t<std::remove_reference_t<RngRng> const>>>::value
+			{
+				tc::size_bounds bounds{0, std::size_t(0)};
+				tc::for_each(this->base_range(), [&](auto const& rng) MAYTHROW {
+					bounds = bounds + tc::size_hint(rng); // MAYTHROW
+				});
+				return bounds;
+			}
+
 			template<typename Self, std::enable_if_t<tc::decayed_derived_from<Self, join_adaptor>>* = nullptr> // use terse syntax when Xcode supports https://cplusplus.github.io/CWG/issues/2369.html
 			friend auto range_output_t_impl(Self&&) -> tc::type::unique_t<tc::type::join_t<tc::type::transform_t<tc::range_output_t<decltype(std::declval<Self>().base_range())>, tc::range_output_t>>> {} // unevaluated
 			
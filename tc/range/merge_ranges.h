@@ -11,26 +11,162 @@
 #include "../algorithm/algorithm.h"
 #include "../algorithm/sort_streaming.h"
 
+#include <optional>
+
 namespace tc {
+	namespace merge_many_detail {
+		template<typename RngRng>
+		auto nonempty_views(RngRng const& rngrng) noexcept {
+			return tc::filter(
+				tc::transform(
+					rngrng,
+					tc_fn(tc::make_view)
+				),
+				tc_fn(!tc::empty)
+			);
+		}
+
+		template<typename RngRng>
+		using view_t = tc::range_value_t<decltype(merge_many_detail::nonempty_views(std::declval<RngRng const&>()))>;
+
+		template<typename Sink, typename View>
+		concept chunk_sink = requires(View& view) { tc::take(view, tc::begin(view)); } &&
+			tc::has_mem_fn_chunk<Sink const&, decltype(tc::take(std::declval<View&>(), tc::begin(std::declval<View&>())))>;
+
+		namespace no_adl {
+			template<typename Sink, typename View>
+			struct chunk_result final {
+				using type = tc::constant<tc::continue_>;
+			};
+
+			template<typename Sink, typename View> requires chunk_sink<Sink, View>
+			struct chunk_result<Sink, View> final {
+				using type = decltype(tc::continue_if_not_break(tc::mem_fn_chunk(), std::declval<Sink const&>(), tc::take(std::declval<View&>(), tc::begin(std::declval<View&>()))));
+			};
+
+			// Tournament tree over k sorted ranges. The ranges are the leaves, every inner node stores the loser of the match
+			// played there, and the overall winner is kept separately. After the winner advanced, only the matches on the path
+			// from its leaf to the root are replayed, one comparison per level, i.e., log2(k) comparisons per element.
+			// Nodes are range indices in heap layout, so the tree occupies k integers. Exhausted ranges lose every match.
+			template<typename View, typename Less>
+			struct loser_tree final : tc::noncopyable {
+				loser_tree(tc::vector<View> vecview, Less const& less) noexcept
+					: m_vecview(tc_move(vecview))
+					, m_less(less)
+					, m_vecnLoser(tc::size(m_vecview))
+					, m_nWinner(0)
+				{
+					auto const nLeaves = tc::size(m_vecview);
+					if( 1 < nLeaves ) {
+						tc::vector<std::size_t> vecnWinner(nLeaves);
+						auto Winner = [&](std::size_t const nNode) noexcept {
+							return nNode < nLeaves ? vecnWinner[nNode] : nNode - nLeaves;
+						};
+						for( std::size_t nNode = nLeaves - 1; 0 < nNode; --nNode ) {
+							auto nWinner = Winner(2 * nNode);
+							auto nLoser = Winner(2 * nNode + 1);
+							if( beats(nLoser, nWinner) ) std::swap(nWinner, nLoser);
+							vecnWinner[nNode] = nWinner;
+							m_vecnLoser[nNode] = nLoser;
+						}
+						m_nWinner = vecnWinner[1];
+					}
+				}
+
+				bool empty() const& noexcept {
+					return tc::empty(m_vecview) || tc::empty(m_vecview[m_nWinner]);
+				}
+
+				std::size_t winner_index() const& noexcept {
+					return m_nWinner;
+				}
+
+				View& winner() & noexcept {
+					_ASSERT(!empty());
+					return m_vecview[m_nWinner];
+				}
+
+				// Best range except the winner, found among the losers of the winner's matches. nullptr if there is none left.
+				View const* runner_up() const& noexcept {
+					std::optional<std::size_t> onRunnerUp;
+					for( auto nNode = (m_nWinner + tc::size(m_vecview)) / 2; 0 < nNode; nNode /= 2 ) {
+						auto const nLoser = m_vecnLoser[nNode];
+						if( !tc::empty(m_vecview[nLoser]) && (!onRunnerUp || beats(nLoser, *onRunnerUp)) ) {
+							onRunnerUp = nLoser;
+						}
+					}
+					return onRunnerUp ? std::addressof(m_vecview[*onRunnerUp]) : nullptr;
+				}
+
+				// To be called after elements were dropped from winner().
+				void replay() & noexcept {
+					auto nWinner = m_nWinner;
+					for( auto nNode = (m_nWinner + tc::size(m_vecview)) / 2; 0 < nNode; nNode /= 2 ) {
+						if( beats(m_vecnLoser[nNode], nWinner) ) std::swap(m_vecnLoser[nNode], nWinner);
+					}
+					m_nWinner = nWinner;
+				}
+
+			private:
+				// Strict, so ties keep the current winner in place.
+				bool beats(std::size_t const nLhs, std::size_t const nRhs) const& noexcept {
+					return !tc::empty(m_vecview[nLhs]) && (
+						tc::empty(m_vecview[nRhs]) ||
+						tc::invoke(m_less, tc::front(m_vecview[nLhs]), tc::front(m_vecview[nRhs]))
+					);
+				}
+
+				tc::vector<View> m_vecview;
+				Less const& m_less;
+				tc::vector<std::size_t> m_vecnLoser; // m_vecnLoser[0] is unused
+				std::size_t m_nWinner;
+			};
+		}
+		using no_adl::loser_tree;
+	}
+
+	// Merges k sorted ranges with a loser tree. If the same range wins repeatedly and the sink accepts chunks,
+	// the elements of that range which do not exceed the runner-up are passed on as a single chunk.
 	template<typename RngRng, typename Less = tc::fn_less>
 	auto merge_many(RngRng&& rngrng, Less&& less = Less()) noexcept {
-		return tc::transform(
-			tc::sort_streaming(
-				tc::filter(
-					tc::transform(
-						std::forward<RngRng>(rngrng),
-						tc_fn(tc::make_view)
-					),
-					tc_fn(!tc::empty)
-				),
-				tc::projected(std::forward<Less>(less), tc::fn_front()),
-				[](auto& rng) noexcept {
-					tc::drop_first_inplace(rng);
-					return !tc::empty(rng);
-				}
-			),
-			tc::fn_front()
-		);
+		using View = merge_many_detail::view_t<RngRng>;
+		using Element = decltype(tc::front(std::declval<View&>()));
+		return tc::generator_range_output<Element>([
+			rngrng = tc::make_reference_or_value(std::forward<RngRng>(rngrng)),
+			less = tc::decay_copy(std::forward<Less>(less))
+		](auto&& sink) MAYTHROW -> tc::common_type_t<
+			decltype(tc::continue_if_not_break(sink, std::declval<Element>())),
+			typename merge_many_detail::no_adl::chunk_result<tc::decay_t<decltype(sink)>, View>::type,
+			tc::constant<tc::continue_>
+		> {
+			merge_many_detail::loser_tree<View, tc::decay_t<Less>> losertree(tc::make_vector(merge_many_detail::nonempty_views(tc::as_const(*rngrng))), less);
+			std::optional<std::size_t> onPrevWinner;
+			while( !losertree.empty() ) {
+				auto& view = losertree.winner();
+				if constexpr( merge_many_detail::chunk_sink<tc::decay_t<decltype(sink)>, View> ) {
+					if( onPrevWinner == losertree.winner_index() ) {
+						auto it = tc::begin(view);
+						if( auto const pviewRunnerUp = losertree.runner_up() ) {
+							decltype(auto) frontRunnerUp = tc::front(*pviewRunnerUp);
+							do {
+								++it;
+							} while( it != tc::end(view) && !tc::invoke(less, frontRunnerUp, *it) );
+						} else {
+							it = tc::end(view);
+						}
+						tc_yield(tc::mem_fn_chunk(), sink, tc::take(view, it)); // MAYTHROW
+						tc::drop_inplace(view, it);
+						losertree.replay();
+						continue;
+					}
+				}
+				onPrevWinner = losertree.winner_index();
+				tc_yield(sink, tc::front(view)); // MAYTHROW
+				tc::drop_first_inplace(view);
+				losertree.replay();
+			}
+			return tc::constant<tc::continue_>();
+		});
 	}
 
 	template<typename RngRng, typename Less = tc::fn_less>
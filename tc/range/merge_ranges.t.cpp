@@ -12,6 +12,8 @@
 
 #include "merge_ranges.h"
 #include "zip_range.h"
+#include "join_adaptor.h"
+#include "iota_range.h"
 
 UNITTESTDEF(merge_ranges_with_simple_usecase) {
 
@@ -140,3 +142,64 @@ UNITTESTDEF(merge_ranges_with_unique_range_2) {
 	_ASSERTEQUAL(vecvecn2[4][0],6);
 	_ASSERTEQUAL(vecvecn2[4][1],7);
 }
+
+namespace {
+	struct chunk_counting_sink final {
+		tc::vector<int>& m_vecn;
+		int& m_nChunkElements;
+
+		void operator()(int const n) const& noexcept {
+			tc::cont_emplace_back(m_vecn, n);
+		}
+
+		template<typename Rng> requires tc::has_size<Rng>
+		void chunk(Rng&& rng) const& noexcept {
+			m_nChunkElements += tc::size(rng);
+			tc::append(m_vecn, rng);
+		}
+	};
+}
+
+UNITTESTDEF(merge_many_loser_tree) {
+	tc::vector<tc::vector<int>> vecvecn;
+	unsigned int nRandom = 1;
+	for( int i = 0; i < 37; ++i ) {
+		tc::vector<int> vecn;
+		for( int j = 0; j < i * 3; ++j ) {
+			nRandom = nRandom * 1103515245 + 12345;
+			tc::cont_emplace_back(vecn, tc::explicit_cast<int>(nRandom >> 16) % 1000);
+		}
+		tc::sort_inplace(vecn);
+		tc::cont_emplace_back(vecvecn, tc_move(vecn));
+	}
+	// a long run, which is passed on as a chunk
+	tc::cont_emplace_back(vecvecn, tc::make_vector(tc::iota(2000, 3000)));
+	tc::cont_emplace_back(vecvecn, tc::vector<int>{2500});
+
+	auto vecnExpected = tc::make_vector(tc::join(vecvecn));
+	tc::sort_inplace(vecnExpected);
+
+	_ASSERT(tc::equal(tc::make_vector(tc::merge_many(vecvecn)), vecnExpected));
+
+	{
+		tc::vector<int> vecn;
+		tc::for_each(tc::merge_many(vecvecn), [&](int const n) noexcept { tc::cont_emplace_back(vecn, n); });
+		_ASSERT(tc::equal(vecn, vecnExpected));
+	}
+	{
+		tc::vector<int> vecn;
+		int nChunkElements = 0;
+		tc::for_each(tc::merge_many(vecvecn), chunk_counting_sink{vecn, nChunkElements});
+		_ASSERT(tc::equal(vecn, vecnExpected));
+		_ASSERT(990 < nChunkElements);
+	}
+
+	_ASSERT(tc::equal(tc::merge_many_unique(vecvecn), tc::make_vector(tc::ordered_unique(vecnExpected))));
+	_ASSERT(tc::empty(tc::make_vector(tc::merge_many(tc::vector<tc::vector<int>>()))));
+	_ASSERT(tc::equal(tc::merge_many(tc::vector<tc::vector<int>>{{}, {3, 4}, {}}), tc::vector<int>{3, 4}));
+
+	// break_ stops the merge
+	int nCount = 0;
+	_ASSERTEQUAL(tc::break_, tc::for_each(tc::merge_many(vecvecn), [&](int) noexcept { return tc::continue_if(10 != ++nCount); }));
+	_ASSERTEQUAL(nCount, 10);
+}
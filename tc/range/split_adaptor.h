@@ -0,0 +1,120 @@
+// think-cell public library
+//
+// Copyright (C) 2016-2023 think-cell Software GmbH
+//
+// Distributed under the Boost Software License, Version 1.0.
+// See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt
+
+#pragma once
+
+#include "../base/assert_defs.h"
+#include "../algorithm/find.h"
+
+#include "range_adaptor.h"
+#include "subrange.h"
+#include "meta.h"
+
+#include <iterator>
+
+namespace tc {
+	namespace split_detail {
+		template<typename It>
+		struct split_index final {
+			It m_itBegin;
+			It m_itDelimiter; // delimiter behind the piece, or end of the base range
+			bool m_bAtEnd;
+
+			friend bool operator==(split_index const& lhs, split_index const& rhs) noexcept {
+				return lhs.m_bAtEnd == rhs.m_bAtEnd && (lhs.m_bAtEnd || lhs.m_itBegin == rhs.m_itBegin);
+			}
+		};
+	}
+
+	namespace no_adl {
+		// Pieces of the base range between delimiters, as subranges of the base range.
+		// If bLines, pieces are lines: a trailing line break does not start another, empty line, and "\r\n" counts as one line break.
+		template<typename Rng, typename T, bool bLines>
+		struct [[nodiscard]] split_adaptor
+			: tc::range_iterator_from_index<
+				split_adaptor<Rng, T, bLines>,
+				split_detail::split_index<tc::iterator_t<std::remove_reference_t<Rng> const>>
+			>
+			, tc::range_adaptor_base_range<Rng>
+		{
+		private:
+			using this_type = split_adaptor;
+			T m_tDelimiter;
+
+		public:
+			using typename this_type::range_iterator_from_index::tc_index;
+			static constexpr bool c_bHasStashingIndex=false;
+
+			template<typename RngRef, typename TRef>
+			constexpr split_adaptor(RngRef&& rng, TRef&& tDelimiter) noexcept
+				: tc::range_adaptor_base_range<Rng>(aggregate_tag, std::forward<RngRef>(rng))
+				, m_tDelimiter(std::forward<TRef>(tDelimiter))
+			{}
+
+		private:
+			constexpr void find_piece(tc_index& idx) const& noexcept {
+				if constexpr( bLines ) {
+					if( tc::end(tc::as_const(this->base_range())) == idx.m_itBegin ) {
+						idx.m_bAtEnd = true;
+						return;
+					}
+				}
+				if constexpr( tc::common_range<std::remove_reference_t<Rng> const> ) {
+					idx.m_itDelimiter = tc::find_first<tc::return_border_before_or_end>(tc::drop(tc::as_const(this->base_range()), idx.m_itBegin), m_tDelimiter);
+				} else { // the end iterator of a sentinel-terminated range is only known once we walk there
+					for( idx.m_itDelimiter = idx.m_itBegin; tc::end(tc::as_const(this->base_range())) != idx.m_itDelimiter && !(*idx.m_itDelimiter == m_tDelimiter); ++idx.m_itDelimiter ) {}
+				}
+			}
+
+			STATIC_FINAL_MOD(constexpr, begin_index)() const& noexcept -> tc_index {
+				tc_index idx{tc::begin(tc::as_const(this->base_range())), tc::begin(tc::as_const(this->base_range())), false};
+				find_piece(idx);
+				return idx;
+			}
+
+			STATIC_FINAL_MOD(constexpr, at_end_index)(tc_index const& idx) const& noexcept -> bool {
+				return idx.m_bAtEnd;
+			}
+
+			STATIC_FINAL_MOD(constexpr, increment_index)(tc_index& idx) const& noexcept -> void {
+				_ASSERTE( !idx.m_bAtEnd );
+				if( tc::end(tc::as_const(this->base_range())) == idx.m_itDelimiter ) {
+					idx.m_bAtEnd = true;
+				} else {
+					idx.m_itBegin = tc_modified(idx.m_itDelimiter, ++_);
+					find_piece(idx);
+				}
+			}
+
+			STATIC_FINAL_MOD(constexpr, dereference_index)(tc_index const& idx) const& noexcept {
+				_ASSERTE( !idx.m_bAtEnd );
+				if constexpr( bLines ) {
+					if( idx.m_itBegin != idx.m_itDelimiter && tc::end(tc::as_const(this->base_range())) != idx.m_itDelimiter ) { // a '\r' without '\n' is not a line break
+						if( auto itLast = tc_modified(idx.m_itDelimiter, --_); '\r' == *itLast ) {
+							return tc::make_iterator_range(idx.m_itBegin, itLast);
+						}
+					}
+				}
+				return tc::make_iterator_range(idx.m_itBegin, idx.m_itDelimiter);
+			}
+		};
+	}
+
+	// Splits rng at every element equal to tDelimiter. n delimiters separate n+1 pieces, which may be empty.
+	template<typename Rng, typename T>
+	constexpr auto split(Rng&& rng, T&& tDelimiter) return_ctor_noexcept(
+		TC_FWD(no_adl::split_adaptor<Rng, tc::decay_t<T>, /*bLines*/false>),
+		(std::forward<Rng>(rng), std::forward<T>(tDelimiter))
+	)
+
+	// Lines of rng without their line breaks "\n" or "\r\n".
+	template<typename Rng> requires tc::bidirectional_range<Rng>
+	constexpr auto lines(Rng&& rng) return_ctor_noexcept(
+		TC_FWD(no_adl::split_adaptor<Rng, tc::range_value_t<Rng>, /*bLines*/true>),
+		(std::forward<Rng>(rng), tc::explicit_cast<tc::range_value_t<Rng>>('\n'))
+	)
+}
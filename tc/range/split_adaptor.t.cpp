@@ -0,0 +1,63 @@
+// think-cell public library
+//
+// Copyright (C) 2016-2023 think-cell Software GmbH
+//
+// Distributed under the Boost Software License, Version 1.0.
+// See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt
+
+#include "../base/assert_defs.h"
+#include "../unittest.h"
+#include "split_adaptor.h"
+#include "filter_adaptor.h"
+#include "join_adaptor.h"
+#include "transform.h"
+#include "../algorithm/append.h"
+#include "../string/format.h"
+#include "../string/make_c_str.h"
+
+namespace {
+	template<typename Rng, typename... Str>
+	void assert_pieces(Rng const& rng, Str const&... str) noexcept {
+		auto const vecstr = tc::make_vector(tc::transform(rng, [](auto const& rngch) noexcept { return tc::make_str<char>(rngch); }));
+		_ASSERTEQUAL(tc::size(vecstr), sizeof...(Str));
+		std::size_t i = 0;
+		(_ASSERT(tc::equal(tc::at(vecstr, i++), str)), ...);
+	}
+}
+
+UNITTESTDEF(split) {
+	assert_pieces(tc::split(tc::make_str<char>("a,bc,,d"), ','), "a", "bc", "", "d");
+	assert_pieces(tc::split(tc::make_str<char>(",a,"), ','), "", "a", "");
+	assert_pieces(tc::split(tc::make_str<char>(""), ','), "");
+	assert_pieces(tc::split(tc::as_c_str("zero;terminated"), ';'), "zero", "terminated");
+
+	// long pieces are found by the vectorized scan
+	auto const strLong = tc::make_str<char>(tc::repeat_n(100, 'x'), "|", tc::repeat_n(40, 'y'));
+	assert_pieces(tc::split(strLong, '|'), tc::make_str<char>(tc::repeat_n(100, 'x')), tc::make_str<char>(tc::repeat_n(40, 'y')));
+
+	// pieces are views into the base range
+	auto const str = tc::make_str<char>("ab cd");
+	auto const rngpiece = tc::split(str, ' ');
+	_ASSERT(tc::ptr_begin(str) + 3 == tc::ptr_begin(*tc_modified(tc::begin(rngpiece), ++_)));
+
+	// composes with other adaptors and is a generator
+	_ASSERTEQUAL(
+		tc::make_str<char>(tc::join(tc::filter(tc::split(tc::make_str<char>("1,,2,3"), ','), [](auto const& rngch) noexcept { return !tc::empty(rngch); }))),
+		"123"
+	);
+	int nSum = 0;
+	tc::for_each(tc::split(tc::make_str<char>("1 20 300"), ' '), [&](auto const& rngch) noexcept {
+		nSum += tc::signed_integer_from_string<int>(rngch);
+	});
+	_ASSERTEQUAL(nSum, 321);
+}
+
+UNITTESTDEF(lines) {
+	assert_pieces(tc::lines(tc::make_str<char>("a\nb\r\n\nc")), "a", "b", "", "c");
+	assert_pieces(tc::lines(tc::make_str<char>("a\n")), "a");
+	assert_pieces(tc::lines(tc::make_str<char>("\r\n")), "");
+	assert_pieces(tc::lines(tc::make_str<char>("a\r")), "a\r");
+	assert_pieces(tc::lines(tc::make_str<char>("a\r\nb\r")), "a", "b\r");
+	assert_pieces(tc::lines(tc::make_str<char>("")));
+	_ASSERT(tc::equal(tc::front(tc::lines(tc::make_str<tc::char16>(UTF16("x\ny")))), UTF16("x")));
+}
@@ -12,6 +12,7 @@
 #include "../base/tc_move.h"
 #include "../base/conditional.h"
 #include "../base/invoke.h"
+#include "../algorithm/size.h"
 
 #include "range_adaptor.h"
 #include "meta.h"
@@ -49,6 +50,10 @@ namespace tc {
 				);
 				return breakorcontinue;
 			}
+
+			constexpr tc::size_bounds size_hint() const& MAYTHROW {
+				return tc::size_hint(this->base_range()).subset();
+			}
 		};
 
 		template< typename Pred, typename Rng >
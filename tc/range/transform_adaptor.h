@@ -18,6 +18,8 @@
 
 #include "transform.h"
 
+#include <functional>
+
 namespace tc {
 	namespace no_adl {
 		template<typename Func, typename Sink>
@@ -31,6 +33,12 @@ namespace tc {
 			constexpr auto operator()(T&& t) const& return_decltype_MAYTHROW(
 				tc::invoke(m_sink, tc::invoke(m_func, std::forward<T>(t)))
 			)
+
+			// Pass chunks on as transformed views, so that the sink still sees a sized, random-access range and can reserve and insert in bulk.
+			template<typename Rng, ENABLE_SFINAE>
+			constexpr auto chunk(Rng&& rng) const& return_decltype_MAYTHROW(
+				SFINAE_VALUE(m_sink).chunk(tc::transform_adaptor<std::reference_wrapper<Func const>, Rng>(std::forward<Rng>(rng), std::cref(m_func)))
+			)
 		};
 	}
 
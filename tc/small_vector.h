@@ -0,0 +1,276 @@
+// think-cell public library
+//
+// Copyright (C) 2016-2023 think-cell Software GmbH
+//
+// Distributed under the Boost Software License, Version 1.0.
+// See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt
+
+#pragma once
+
+#include "static_vector.h"
+
+#include <algorithm>
+#include <memory>
+
+MODIFY_WARNINGS_BEGIN(((disable)(4297))) // 'function' : function assumed not to throw an exception but does.
+
+namespace tc {
+	namespace small_vector_adl {
+		// Vector that keeps up to N elements inline in the storage of a tc::static_vector and moves them to the heap when it grows beyond.
+		// Once on the heap, the elements stay there, even if the vector shrinks again.
+		template< typename T, tc::static_vector_size_t N >
+		struct [[nodiscard]] small_vector
+			: tc::range_iterator_from_index<
+				small_vector<T, N>,
+				std::size_t
+			>
+		{
+		private:
+			using this_type = small_vector;
+		public:
+			using typename this_type::range_iterator_from_index::tc_index;
+
+			using size_type = std::size_t;
+			using difference_type = std::ptrdiff_t;
+			using reference = T&;
+			using value_type = T;
+
+			static constexpr bool c_bHasStashingIndex=false;
+
+			static_assert( 0 < N );
+
+			small_vector() noexcept {}
+
+			template <typename... Args> requires
+				(0 < sizeof...(Args)) &&
+				(tc::econstructionIMPLICIT==tc::elementwise_construction_restrictiveness<T, Args...>::value)
+			small_vector(tc::aggregate_tag_t, Args&& ... args) MAYTHROW {
+				reserve(sizeof...(Args)); // MAYTHROW
+				(emplace_back(std::forward<Args>(args)), ...); // MAYTHROW
+			}
+
+			template <typename... Args> requires
+				(0 == sizeof...(Args)) ||
+				(tc::econstructionEXPLICIT==tc::elementwise_construction_restrictiveness<T, Args...>::value)
+			explicit small_vector(tc::aggregate_tag_t, Args&& ... args) MAYTHROW {
+				reserve(sizeof...(Args)); // MAYTHROW
+				(tc::cont_emplace_back(*this, std::forward<Args>(args)), ...); // cont_emplace_back for lazy explicit_cast
+			}
+
+			small_vector(small_vector const& vec) MAYTHROW {
+				tc::append(*this, vec); // MAYTHROW
+			}
+
+			small_vector(small_vector&& vec) noexcept(std::is_nothrow_move_constructible<T>::value)
+				: m_vecInline(tc_move(vec.m_vecInline))
+				, m_pt(std::exchange(vec.m_pt, nullptr))
+				, m_nSize(std::exchange(vec.m_nSize, 0))
+				, m_nCapacity(std::exchange(vec.m_nCapacity, 0))
+			{
+				vec.m_vecInline.clear();
+			}
+
+			small_vector& operator=(small_vector const& vec) & MAYTHROW {
+				if( std::addressof(vec)!=this ) {
+					assign(vec); // MAYTHROW
+				}
+				return *this;
+			}
+
+			small_vector& operator=(small_vector&& vec) & noexcept(std::is_nothrow_move_constructible<T>::value) {
+				_ASSERTE( std::addressof(vec)!=this ); // self assignment from rvalues should not happen, rvalues must be expiring
+				free_heap();
+				m_vecInline = tc_move(vec.m_vecInline);
+				vec.m_vecInline.clear();
+				m_pt = std::exchange(vec.m_pt, nullptr);
+				m_nSize = std::exchange(vec.m_nSize, 0);
+				m_nCapacity = std::exchange(vec.m_nCapacity, 0);
+				return *this;
+			}
+
+			~small_vector() {
+				free_heap();
+			}
+
+			// query state
+			[[nodiscard]] bool on_heap() const& noexcept {
+				return nullptr != m_pt;
+			}
+			[[nodiscard]] size_type size() const& noexcept {
+				return on_heap() ? m_nSize : m_vecInline.size();
+			}
+			[[nodiscard]] size_type capacity() const& noexcept {
+				return on_heap() ? m_nCapacity : N;
+			}
+			[[nodiscard]] T* data() & noexcept {
+				return on_heap() ? m_pt : m_vecInline.data();
+			}
+			[[nodiscard]] T const* data() const& noexcept {
+				return on_heap() ? m_pt : m_vecInline.data();
+			}
+
+		private:
+			STATIC_FINAL(begin_index)() const& noexcept -> tc_index { return 0; }
+			STATIC_FINAL(end_index)() const& noexcept -> tc_index { return size(); }
+			STATIC_FINAL(increment_index)(tc_index& idx) const& noexcept -> void { ++idx; }
+			STATIC_FINAL(decrement_index)(tc_index& idx) const& noexcept -> void { --idx; }
+			STATIC_FINAL(advance_index)(tc_index& idx, difference_type d) const& noexcept -> void { idx += static_cast<tc_index>(d); }
+			STATIC_FINAL(distance_to_index)(tc_index const& idxLhs, tc_index const& idxRhs) const& noexcept -> difference_type { return tc::explicit_cast<difference_type>(idxRhs) - tc::explicit_cast<difference_type>(idxLhs); }
+			STATIC_FINAL(middle_point)( tc_index & idxBegin, tc_index const& idxEnd ) const& noexcept -> void {
+				this->advance_index(idxBegin,this->distance_to_index(idxBegin,idxEnd)/2);
+			}
+			STATIC_FINAL(dereference_index)(tc_index idx) & noexcept -> T& { return data()[idx]; }
+			STATIC_FINAL(dereference_index)(tc_index idx) const& noexcept -> T const& { return data()[idx]; }
+			STATIC_FINAL(index_to_address)(const tc_index& idx)& noexcept ->  T* { return data() + idx; }
+			STATIC_FINAL(index_to_address)(const tc_index& idx) const& noexcept ->  const T* { return data() + idx; }
+
+		public:
+			// modify
+			template<typename... Args>
+			T& emplace_back(Args&& ... args) & MAYTHROW {
+				if( !on_heap() ) {
+					if( !m_vecInline.full() ) {
+						return m_vecInline.emplace_back(std::forward<Args>(args)...); // MAYTHROW
+					}
+				} else if( m_nSize < m_nCapacity ) {
+					auto& t = *std::construct_at(m_pt + m_nSize, std::forward<Args>(args)...); // MAYTHROW
+					++m_nSize;
+					return t;
+				}
+				// Construct the new element before relocating the others, because args may refer to one of them.
+				auto const nSize = size();
+				auto const nCapacity = tc::max(nSize * 2, nSize + 1);
+				T* const pt = std::allocator<T>().allocate(nCapacity); // MAYTHROW
+				try {
+					std::construct_at(pt + nSize, std::forward<Args>(args)...); // MAYTHROW
+				} catch(...) {
+					std::allocator<T>().deallocate(pt, nCapacity);
+					throw;
+				}
+				relocate(pt, nCapacity, 1); // MAYTHROW
+				return pt[nSize];
+			}
+
+			T& push_back(T const& t) & MAYTHROW {
+				return emplace_back(t);
+			}
+			T& push_back(T&& t) & MAYTHROW {
+				return emplace_back(tc_move(t));
+			}
+
+			void pop_back() & noexcept {
+				if( on_heap() ) {
+					_ASSERTE( 0 < m_nSize );
+					--m_nSize;
+					std::destroy_at(m_pt + m_nSize);
+				} else {
+					m_vecInline.pop_back();
+				}
+			}
+
+			void reserve(size_type const n) & MAYTHROW {
+				if( capacity() < n ) {
+					relocate(std::allocator<T>().allocate(n), n, 0); // MAYTHROW
+				}
+			}
+
+			// Random access insert, used by tc::appender_type for chunks of random access ranges.
+			template<typename ItPos, typename It>
+			void insert(ItPos const& itPos, It itBegin, It itEnd) & MAYTHROW {
+				auto const nPos = tc::explicit_cast<size_type>(itPos - tc::begin(tc::as_const(*this)));
+				auto const nSize = size();
+				reserve(nSize + tc::explicit_cast<size_type>(itEnd - itBegin)); // MAYTHROW
+				for( ; itBegin != itEnd; ++itBegin ) {
+					emplace_back(*itBegin); // MAYTHROW
+				}
+				std::rotate(data() + nPos, data() + nSize, data() + size());
+			}
+
+			void clear() & noexcept {
+				shrink(0);
+			}
+
+			template<typename Rng>
+			void assign(Rng&& rng) & MAYTHROW {
+				clear();
+				tc::append( *this, std::forward<Rng>(rng) ); // MAYTHROW
+			}
+
+			void resize(size_type const n) & MAYTHROW {
+				if (size() < n) {
+					reserve(n); // MAYTHROW
+					do {
+						emplace_back(); // MAYTHROW
+					} while (n != size());
+				} else {
+					shrink(n);
+				}
+			}
+
+			template<typename It>
+			void take_inplace( It const& it ) & noexcept {
+				shrink(it.get_index());
+			}
+
+			template<typename It>
+			void drop_inplace(It&& it) & noexcept {
+				auto const nDrop = it.get_index();
+				_ASSERTE(nDrop<=size());
+				if (nDrop!=0) {
+					std::move(data() + nDrop, data() + size(), data());
+					shrink(size() - nDrop);
+				}
+			}
+
+		private:
+			void shrink(size_type const n) & noexcept {
+				_ASSERTE( n <= size() );
+				while (n < size()) {
+					pop_back();
+				}
+			}
+
+			// Moves the elements into the new heap buffer pt, which already holds nConstructed elements behind them.
+			void relocate(T* const pt, size_type const nCapacity, size_type const nConstructed) & MAYTHROW {
+				auto const nSize = size();
+				try {
+					if constexpr( std::is_nothrow_move_constructible<T>::value || !std::is_copy_constructible<T>::value ) {
+						std::uninitialized_move(data(), data() + nSize, pt); // MAYTHROW
+					} else {
+						std::uninitialized_copy(data(), data() + nSize, pt); // MAYTHROW, copy to keep the elements intact if it throws
+					}
+				} catch(...) {
+					std::destroy(pt + nSize, pt + nSize + nConstructed);
+					std::allocator<T>().deallocate(pt, nCapacity);
+					throw;
+				}
+				free_heap();
+				m_vecInline.clear();
+				m_pt = pt;
+				m_nSize = nSize + nConstructed;
+				m_nCapacity = nCapacity;
+			}
+
+			void free_heap() & noexcept {
+				if( on_heap() ) {
+					std::destroy(m_pt, m_pt + m_nSize);
+					std::allocator<T>().deallocate(m_pt, m_nCapacity);
+					m_pt = nullptr;
+					m_nSize = 0;
+					m_nCapacity = 0;
+				}
+			}
+
+			tc::static_vector<T, N> m_vecInline;
+			T* m_pt = nullptr; // heap storage, once the elements do not fit into m_vecInline anymore
+			size_type m_nSize = 0;
+			size_type m_nCapacity = 0;
+		};
+	} // small_vector_adl
+	using small_vector_adl::small_vector;
+
+	template< typename T, tc::static_vector_size_t N >
+	struct range_filter_by_move_element<tc::small_vector<T,N>> : tc::constant<true> {};
+}
+
+MODIFY_WARNINGS_END
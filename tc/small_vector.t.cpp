@@ -0,0 +1,65 @@
+// think-cell public library
+//
+// Copyright (C) 2016-2023 think-cell Software GmbH
+//
+// Distributed under the Boost Software License, Version 1.0.
+// See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt
+
+#include "base/assert_defs.h"
+#include "unittest.h"
+#include "small_vector.h"
+#include "algorithm/filter_inplace.h"
+#include "range/iota_range.h"
+
+#include <string>
+
+UNITTESTDEF(small_vector_spill) {
+	tc::small_vector<int, 4> vecn;
+	tc::append(vecn, tc::iota(0, 4));
+	_ASSERT(!vecn.on_heap());
+	_ASSERTEQUAL(tc::size(vecn), 4);
+
+	tc::cont_emplace_back(vecn, 4);
+	_ASSERT(vecn.on_heap());
+	TEST_RANGE_EQUAL(vecn, tc::iota(0, 5));
+
+	tc::append(vecn, tc::iota(5, 100));
+	TEST_RANGE_EQUAL(vecn, tc::iota(0, 100));
+	_ASSERTEQUAL(tc::back(vecn), 99);
+
+	tc::filter_inplace(vecn, [](int const n) noexcept { return 0 == n % 10; });
+	TEST_RANGE_EQUAL(vecn, tc::transform(tc::iota(0, 10), [](int const n) noexcept { return n * 10; }));
+
+	// emplace_back from an element of the vector itself while it spills
+	tc::small_vector<int, 2> vecnAlias(tc::aggregate_tag, 1, 2);
+	_ASSERT(!vecnAlias.on_heap());
+	vecnAlias.emplace_back(tc::front(vecnAlias));
+	TEST_RANGE_EQUAL(vecnAlias, tc::make_array(tc::aggregate_tag, 1, 2, 1));
+}
+
+UNITTESTDEF(small_vector_nontrivial) {
+	tc::small_vector<std::string, 2> vecstr;
+	tc::cont_emplace_back(vecstr, "a");
+	tc::cont_emplace_back(vecstr, "b");
+	auto vecstrCopy = vecstr;
+	tc::cont_emplace_back(vecstr, "c");
+	_ASSERT(vecstr.on_heap());
+	_ASSERT(!vecstrCopy.on_heap());
+	_ASSERTEQUAL(tc::size(vecstrCopy), 2);
+
+	auto vecstrMoved = tc_move(vecstr);
+	_ASSERT(tc::empty(vecstr));
+	_ASSERTEQUAL(tc::size(vecstrMoved), 3);
+	_ASSERTEQUAL(tc::back(vecstrMoved), "c");
+
+	vecstrMoved.insert(tc::begin(vecstrMoved), tc::begin(vecstrCopy), tc::end(vecstrCopy));
+	_ASSERTEQUAL(tc::size(vecstrMoved), 5);
+	_ASSERTEQUAL(tc::at(vecstrMoved, 0), "a");
+	_ASSERTEQUAL(tc::at(vecstrMoved, 2), "a");
+	_ASSERTEQUAL(tc::at(vecstrMoved, 4), "c");
+
+	tc::take_first_inplace(vecstrMoved, 2);
+	_ASSERTEQUAL(tc::size(vecstrMoved), 2);
+	vecstrMoved = vecstrCopy;
+	_ASSERTEQUAL(tc::back(vecstrMoved), "b");
+}
@@ -112,7 +112,7 @@ namespace tc {
 			// This specialization for trivially-assignable types is usable in constant expressions.
 			// The normal version of emplace_back cannot be used in constant expressions, because it uses placement new.
 			template<typename... Args>
-			constexpr typename std::enable_if<std::is_trivially_assignable<T&, T>::value && noexcept(T(std::declval<Args&&>()...)), T&>::type emplace_back(Args&& ... args) & noexcept {
+			constexpr typename std::enable_if<std::is_trivially_assignable<T&, T>::value && std::is_nothrow_constructible<T, Args&&...>::value, T&>::type emplace_back(Args&& ... args) & noexcept {
 				_ASSERTE(!this->full());
 				T& t = m_a.m_at[this->m_iEnd];
 				++this->m_iEnd;
@@ -121,7 +121,7 @@ namespace tc {
 			}
 
 			template<typename... Args>
-			typename std::enable_if < !std::is_trivially_assignable<T&, T>::value || !noexcept(T(std::declval<Args&&>()...)), T&>::type emplace_back(Args&& ... args) & noexcept(noexcept(T(std::forward<Args>(args)...))) {
+			typename std::enable_if < !std::is_trivially_assignable<T&, T>::value || !std::is_nothrow_constructible<T, Args&&...>::value, T&>::type emplace_back(Args&& ... args) & noexcept(noexcept(T(std::forward<Args>(args)...))) {
 				_ASSERTE(!this->full());
 				T& t = m_a.m_at[this->m_iEnd];
 				++this->m_iEnd;
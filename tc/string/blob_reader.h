@@ -0,0 +1,126 @@
+// think-cell public library
+//
+// Copyright (C) 2016-2023 think-cell Software GmbH
+//
+// Distributed under the Boost Software License, Version 1.0.
+// See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt
+
+#pragma once
+
+#include "../base/assert_defs.h"
+#include "../base/explicit_cast.h"
+#include "../range/subrange.h"
+#include "../range/iota_range.h"
+#include "../range/transform_adaptor.h"
+#include "../algorithm/size.h"
+#include "../tuple.h"
+
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <optional>
+
+namespace tc {
+	struct blob_parse_exception final {};
+
+	namespace no_adl {
+		// Reads the binary formats written by tc::as_blob, tc::range_as_blob, tc::size_prefixed and tc::bool_prefixed
+		// from contiguous memory, e.g., a tc::vector<unsigned char> or a memory-mapped file. Like the writers, values are
+		// in native byte order. All reads check the bounds of the buffer and throw tc::blob_parse_exception if the data
+		// is truncated or malformed.
+		struct [[nodiscard]] blob_reader final {
+			template<tc::contiguous_range Rng>
+			explicit blob_reader(Rng const& rngblob) noexcept
+				: m_pb(tc::ptr_begin(rngblob))
+				, m_pbEnd(tc::ptr_end(rngblob))
+			{
+				static_assert(std::is_same<tc::range_value_t<Rng>, unsigned char>::value, "use tc::range_as_blob");
+			}
+
+			bool empty() const& noexcept {
+				return m_pb == m_pbEnd;
+			}
+
+			// The bytes that have not been read yet.
+			tc::span<unsigned char const> remaining() const& noexcept {
+				return tc::make_iterator_range(m_pb, m_pbEnd);
+			}
+
+			// Reads values written by tc::as_blob. The bounds are checked once for all of them.
+			// Returns a single value or a tc::tuple of values.
+			template<typename... T> requires (0 < sizeof...(T))
+			auto read() & THROW(tc::blob_parse_exception) {
+				require((0 + ... + sizeof(T))); // THROW(tc::blob_parse_exception)
+				if constexpr( 1 == sizeof...(T) ) {
+					return read_unchecked<T...>(); // THROW(tc::blob_parse_exception)
+				} else {
+					return tc::tuple<T...>{{ {read_unchecked<T>()}... }}; // THROW(tc::blob_parse_exception), braced initialization reads left to right
+				}
+			}
+
+			// Reads n values written by tc::range_as_blob without copying them. For types with alignof(T) == 1, returns a tc::span
+			// into the buffer. The writer does not align other types, so they are returned as a random access range that reads
+			// every value with std::memcpy.
+			template<typename T>
+			auto read_range(std::size_t const n) & THROW(tc::blob_parse_exception) {
+				static_assert( std::is_trivially_copyable<T>::value && std::is_default_constructible<T>::value );
+				static_assert( !std::is_same<T, bool>::value, "bools must be validated, use read<bool>()" );
+				if( tc::explicit_cast<std::size_t>(m_pbEnd - m_pb) / sizeof(T) < n ) throw tc::blob_parse_exception();
+				auto const pb = m_pb;
+				m_pb += n * sizeof(T);
+				if constexpr( 1 == alignof(T) ) {
+					auto const pt = reinterpret_cast<T const*>(pb);
+					return tc::span<T const>(tc::make_iterator_range(pt, pt + n));
+				} else {
+					return tc::transform(tc::iota(std::size_t(0), n), [pb](std::size_t const i) noexcept {
+						T t;
+						std::memcpy(std::addressof(t), pb + i * sizeof(T), sizeof(T)); // pb may be unaligned
+						return t;
+					});
+				}
+			}
+
+			// Reads a range written by tc::size_prefixed(tc::range_as_blob-able range), see read_range.
+			template<typename T>
+			auto read_size_prefixed() & THROW(tc::blob_parse_exception) {
+				return read_range<T>(read<std::uint32_t>()); // THROW(tc::blob_parse_exception)
+			}
+
+			// Reads an optional written by tc::bool_prefixed(std::optional<T>).
+			template<typename T>
+			std::optional<T> read_bool_prefixed() & THROW(tc::blob_parse_exception) {
+				if( read<bool>() ) { // THROW(tc::blob_parse_exception)
+					return read<T>(); // THROW(tc::blob_parse_exception)
+				} else {
+					return std::nullopt;
+				}
+			}
+
+		private:
+			void require(std::size_t const nBytes) const& THROW(tc::blob_parse_exception) {
+				if( tc::explicit_cast<std::size_t>(m_pbEnd - m_pb) < nBytes ) throw tc::blob_parse_exception();
+			}
+
+			template<typename T>
+			T read_unchecked() & THROW(tc::blob_parse_exception) {
+				static_assert( std::is_trivially_copyable<T>::value && std::is_default_constructible<T>::value );
+				_ASSERTDEBUG( sizeof(T) <= tc::explicit_cast<std::size_t>(m_pbEnd - m_pb) );
+				if constexpr( std::is_same<T, bool>::value ) {
+					static_assert( 1 == sizeof(bool) );
+					unsigned char const b = *m_pb++;
+					if( 1 < b ) throw tc::blob_parse_exception(); // any other object representation of bool is undefined behavior
+					return 1 == b;
+				} else {
+					T t;
+					std::memcpy(std::addressof(t), m_pb, sizeof(T)); // m_pb may be unaligned
+					m_pb += sizeof(T);
+					return t;
+				}
+			}
+
+			unsigned char const* m_pb;
+			unsigned char const* m_pbEnd;
+		};
+	}
+	using no_adl::blob_reader;
+}
@@ -0,0 +1,79 @@
+// think-cell public library
+//
+// Copyright (C) 2016-2023 think-cell Software GmbH
+//
+// Distributed under the Boost Software License, Version 1.0.
+// See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt
+
+#include "../base/assert_defs.h"
+#include "../unittest.h"
+#include "../algorithm/append.h"
+#include "format.h"
+#include "blob_reader.h"
+
+UNITTESTDEF(blob_reader_roundtrip) {
+	auto const str = tc::make_str<char>("abc");
+	std::optional<double> const od = 1.5;
+	std::optional<double> const odEmpty;
+	auto const vecb = tc::make_vector(tc::concat(
+		tc::as_blob(std::int16_t(-2)),
+		tc::size_prefixed(str),
+		tc::as_blob(std::uint64_t(7)),
+		tc::bool_prefixed(od),
+		tc::bool_prefixed(odEmpty),
+		tc::size_prefixed(tc::empty_range())
+	));
+
+	tc::blob_reader reader(vecb);
+	_ASSERTEQUAL(reader.read<std::int16_t>(), -2);
+	auto const rngch = reader.read_size_prefixed<char>();
+	_ASSERT(tc::equal(rngch, str));
+	_ASSERT(tc::ptr_begin(vecb) + 6 == reinterpret_cast<unsigned char const*>(tc::ptr_begin(rngch))); // view into the buffer
+	_ASSERTEQUAL(reader.read<std::uint64_t>(), 7u);
+	_ASSERTEQUAL(reader.read_bool_prefixed<double>(), od);
+	_ASSERT(!reader.read_bool_prefixed<double>());
+	_ASSERT(tc::empty(reader.read_size_prefixed<int>()));
+	_ASSERT(reader.empty());
+}
+
+UNITTESTDEF(blob_reader_unaligned) {
+	tc::vector<double> const vecf{1.5, -2.25, 1e300};
+	auto const vecb = tc::make_vector(tc::concat(tc::as_blob(std::uint8_t(1)), tc::size_prefixed(vecf))); // the doubles start at an odd offset
+
+	tc::blob_reader reader(vecb);
+	_ASSERTEQUAL(reader.read<std::uint8_t>(), 1);
+	auto const rngf = reader.read_size_prefixed<double>();
+	_ASSERTEQUAL(tc::size(rngf), 3);
+	TEST_RANGE_EQUAL(rngf, vecf);
+	_ASSERT(reader.empty());
+}
+
+UNITTESTDEF(blob_reader_message) {
+	auto const vecb = tc::make_vector(tc::concat(tc::as_blob(std::int32_t(1)), tc::as_blob(true), tc::as_blob(std::int32_t(3))));
+	{
+		tc::blob_reader reader(vecb);
+		auto const [n0, b, n1] = reader.read<std::int32_t, bool, std::int32_t>();
+		_ASSERTEQUAL(n0, 1);
+		_ASSERT(b);
+		_ASSERTEQUAL(n1, 3);
+		_ASSERT(reader.empty());
+	}
+
+	auto const ExpectFailure = [](auto const& rngb, auto Read) noexcept {
+		tc::blob_reader reader(rngb);
+		try {
+			Read(reader);
+			_ASSERTFALSE;
+		} catch( tc::blob_parse_exception const& ) {
+		}
+	};
+	// truncated
+	ExpectFailure(tc::begin_next<tc::return_take>(vecb, 8), [](tc::blob_reader& reader) MAYTHROW { static_cast<void>(reader.read<std::int32_t, bool, std::int32_t>()); });
+	ExpectFailure(tc::begin_next<tc::return_take>(vecb, 3), [](tc::blob_reader& reader) MAYTHROW { static_cast<void>(reader.read<std::int32_t>()); });
+	// size prefix beyond the end of the buffer
+	auto const vecbSize = tc::make_vector(tc::concat(tc::as_blob(std::uint32_t(100)), tc::range_as_blob("ab")));
+	ExpectFailure(vecbSize, [](tc::blob_reader& reader) MAYTHROW { static_cast<void>(reader.read_size_prefixed<char>()); });
+	// malformed bool
+	auto const vecbBool = tc::make_vector(tc::as_blob(std::uint8_t(2)));
+	ExpectFailure(vecbBool, [](tc::blob_reader& reader) MAYTHROW { static_cast<void>(reader.read<bool>()); });
+}
@@ -14,8 +14,10 @@
 #include "../algorithm/empty.h"
 #include "../algorithm/compare.h"
 #include "../range/range_adaptor.h"
+#include "../range/subrange.h"
 
 #include "value_restrictive.h"
+#include "transcode_utf.h"
 
 namespace tc {
 	namespace codeunit_sequence_size_detail {
@@ -463,6 +465,38 @@ namespace tc {
 	}
 
 	namespace convert_enc_detail {
+		// UTF-8 -> UTF-16 and UTF-16 -> UTF-8 of contiguous memory is done by the bulk transcoder in transcode_utf.h.
+		template<typename Rng, typename Dst>
+		concept bulk_transcodable = tc::contiguous_range<Rng> && tc::common_range<Rng> && (
+			(std::same_as<tc::range_value_t<Rng>, char> && std::same_as<Dst, tc::char16>) ||
+			(std::same_as<tc::range_value_t<Rng>, tc::char16> && std::same_as<Dst, char>)
+		);
+
+		// Transcodes the code points starting in [pSrc, pLimit). Like SStringConversionRange, each invalid sequence
+		// is replaced by a single U+FFFD REPLACEMENT CHARACTER. Returns the end of the output.
+		template<typename Src, typename Dst>
+		Dst* transcode(Src const*& pSrc, Src const* const pLimit, Src const* const pEnd, Dst* pDst) noexcept {
+			for(;;) {
+				auto const result = transcode_utf_detail::transcode_valid(pSrc, pLimit, pEnd, pDst);
+				pSrc = result.m_pSrc;
+				pDst = result.m_pDst;
+				if( pLimit <= pSrc ) return pDst;
+
+				_ASSERTNOTIFYFALSE; // invalid code unit sequence
+				for( int i = 0; i < tc::codepoint_codeunit_count<Dst>(0xfffd); ++i ) {
+					*pDst++ = tc::codepoint_codeunit_at<Dst>(0xfffd, i);
+				}
+				// skip the sequence the same way as tc::codepoint_increment_index
+				auto const onSequenceSize = tc::codeunit_sequence_size_raw(*pSrc);
+				++pSrc;
+				if( onSequenceSize ) {
+					for( int i = 1; i < *onSequenceSize && pSrc < pEnd && tc::is_trailing_codeunit(*pSrc); ++i ) {
+						++pSrc;
+					}
+				}
+			}
+		}
+
 		template<tc::char_like Dst, typename Src>
 		[[nodiscard]] decltype(auto) with_sink_impl(Src&& src) noexcept {
 			return tc::generator_range_output<Dst>([src=tc::make_reference_or_value(std::forward<Src>(src))](auto&& sink) MAYTHROW {
@@ -516,10 +550,28 @@ namespace tc {
 				m_sink(ch)
 			)
 
-			template<typename Rng, std::enable_if_t<tc::range_with_iterators<Rng> && tc::char_like<tc::range_value_t<Rng>>>* = nullptr> // terse syntax triggers VS17.1 ICE
+			template<typename Rng, std::enable_if_t<tc::range_with_iterators<Rng> && tc::char_like<tc::range_value_t<Rng>> && !convert_enc_detail::bulk_transcodable<Rng, Dst>>* = nullptr> // terse syntax triggers VS17.1 ICE
 			auto chunk(Rng&& rng) const& return_decltype_MAYTHROW(
 				tc::for_each(tc::convert_enc<Dst>(std::forward<Rng>(rng)), m_sink)
 			)
+
+			// Transcode block-wise into a buffer and pass the buffer on as chunk.
+			template<typename Rng, std::enable_if_t<convert_enc_detail::bulk_transcodable<Rng, Dst>>* = nullptr>
+			auto chunk(Rng&& rng) const& MAYTHROW -> tc::common_type_break_or_continue_t<decltype(tc::for_each(tc::make_iterator_range(std::declval<Dst*>(), std::declval<Dst*>()), m_sink))> {
+				using Src = tc::range_value_t<Rng>;
+				static constexpr std::size_t c_nBuffer = 1024;
+				static constexpr std::size_t c_nBlock = c_nBuffer / tc::transcode_utf_detail::max_dst_size<Dst>(1);
+				Dst achBuffer[c_nBuffer + 1]; // the last code point of a block may extend beyond the block and need one more code unit
+
+				Src const* pSrc = std::to_address(tc::begin(rng));
+				Src const* const pEnd = std::to_address(tc::end(rng));
+				while( pSrc < pEnd ) {
+					Src const* const pLimit = tc::explicit_cast<std::size_t>(pEnd - pSrc) < c_nBlock ? pEnd : pSrc + c_nBlock;
+					Dst* const pDst = convert_enc_detail::transcode(pSrc, pLimit, pEnd, achBuffer);
+					tc_return_if_break(tc::for_each(tc::make_iterator_range(achBuffer, pDst), m_sink)) // MAYTHROW
+				}
+				return tc::constant<tc::continue_>();
+			}
 		};
 	}
 
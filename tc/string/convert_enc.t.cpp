@@ -7,6 +7,9 @@
 // See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt
 
 #include "../base/assert_defs.h"
+#include "../unittest.h"
+#include "../algorithm/append.h"
+#include "../range/subrange.h"
 #include "convert_enc.h"
 
 namespace {
@@ -49,3 +52,83 @@ static_assert(IsLeading(UTF16('\xD800')));
 static_assert(IsLeading(UTF16('\xDBFF')));
 static_assert(IsTrailing(UTF16('\xDC00')));
 static_assert(IsTrailing(UTF16('\xDFFF')));
+
+namespace {
+	// ASCII runs long enough for the vectorized path, interrupted by 2-, 3- and 4-byte sequences
+	tc::string<char> TestString(int const nRepeat) noexcept {
+		tc::string<char> str;
+		for( int i = 0; i < nRepeat; ++i ) {
+			tc::append(str, "The quick brown fox jumps over the lazy dog. ", "\xc3\xa4\xe2\x82\xac\xf0\x9f\x98\x80", tc::begin_next<tc::return_take>(" 0123456789abcdefghijklmnopqrstuvwxyz", i % 37));
+		}
+		return str;
+	}
+}
+
+UNITTESTDEF(convert_enc_bulk) {
+	for( int nRepeat = 0; nRepeat < 40; ++nRepeat ) {
+		auto const str = TestString(nRepeat);
+
+		// tc::append transcodes directly into the string
+		auto const str16 = tc::make_str<tc::char16>(str);
+		_ASSERT(tc::equal(str16, tc::make_vector(tc::convert_enc<tc::char16>(str))));
+		auto const str8 = tc::make_str<char>(str16);
+		TEST_RANGE_EQUAL(str8, str);
+		TEST_RANGE_EQUAL(str8, tc::make_vector(tc::convert_enc<char>(str16)));
+
+		// convert_enc_sink transcodes chunks into a buffer
+		auto const rngchGenerator = tc::generator_range_output<char const&>([&](auto&& sink) MAYTHROW {
+			return tc::for_each(str, tc_move_if_owned(sink));
+		});
+		tc::vector<tc::char16> vecch16;
+		tc::for_each(tc::convert_enc<tc::char16>(rngchGenerator), [&](tc::char16 const ch) noexcept { tc::cont_emplace_back(vecch16, ch); });
+		_ASSERT(tc::equal(vecch16, str16));
+	}
+}
+
+#ifdef NDEBUG // invalid input is reported by _ASSERTNOTIFYFALSE in debug builds
+namespace {
+	// char16 cannot be streamed by TEST_RANGE_EQUAL
+	template<typename Rng>
+	auto CodeUnits(Rng const& rng) noexcept {
+		return tc::make_vector(tc::transform(rng, [](auto const ch) noexcept { return static_cast<int>(ch); }));
+	}
+}
+
+UNITTESTDEF(convert_enc_bulk_invalid) {
+	// Each invalid sequence is surrounded by ASCII runs long enough for the vectorized path, and also placed at both ends of the input.
+	auto const Test = [](auto const& rngchInvalid) noexcept {
+		using Src = tc::range_value_t<decltype(rngchInvalid)>;
+		using Dst = std::conditional_t<std::is_same<Src, char>::value, tc::char16, char>;
+		auto const strPad = tc::make_str<Src>("The quick brown fox jumps over the lazy dog.");
+		for( auto const& str : {
+			tc::make_str(rngchInvalid),
+			tc::make_str(strPad, rngchInvalid),
+			tc::make_str(rngchInvalid, strPad),
+			tc::make_str(strPad, rngchInvalid, strPad)
+		} ) {
+			TEST_RANGE_EQUAL(CodeUnits(tc::make_vector(tc::convert_enc<Dst>(str))), CodeUnits(tc::make_str<Dst>(str)));
+		}
+	};
+
+	// UTF-8 -> UTF-16
+	Test("\xc3"); // truncated 2-byte sequence
+	Test("\xe2\x82"); // truncated 3-byte sequence
+	Test("\xf0\x9f\x98"); // truncated 4-byte sequence
+	Test("\xe2\x82" "A"); // truncated sequence followed by ASCII
+	Test("\x80\xbf"); // trailing bytes without leading byte
+	Test("\xc0\xaf"); // overlong '/'
+	Test("\xe0\x80\xaf"); // overlong '/'
+	Test("\xf0\x80\x80\xaf"); // overlong '/'
+	Test("\xf4\x90\x80\x80"); // beyond U+10FFFF
+	Test("\xf8\x88\x80\x80\x80"); // 5-byte sequence
+	Test("\xed\xa0\x80"); // lone high surrogate U+D800
+	Test("\xed\xbf\xbf"); // lone low surrogate U+DFFF
+
+	// UTF-16 -> UTF-8
+	Test(UTF16("\xD800")); // lone high surrogate
+	Test(UTF16("\xDFFF")); // lone low surrogate
+	Test(UTF16("\xD83D" "A")); // high surrogate followed by ASCII
+	Test(UTF16("\xDE00\xD83D")); // surrogate pair in wrong order
+	Test(UTF16("\xD83D\xD83D\xDE00")); // high surrogate followed by a valid pair
+}
+#endif
@@ -10,65 +10,99 @@
 #include "../base/assert_defs.h"
 #include "../base/explicit_cast.h"
 #include "../base/bit_cast.h"
+#include "../base/string_template_param.h"
 #include "../algorithm/for_each.h"
 #include "../algorithm/empty.h"
 #include "../algorithm/minmax.h"
+#include "../algorithm/size.h"
 #include "../range/subrange.h"
 #include "../range/concat_adaptor.h"
 #include "../range/repeat_n.h"
+#include "../range/range_adaptor.h"
+#include "../tuple.h"
+#include "../container/container.h"
+#include "../container/insert.h"
 #include "value_restrictive.h"
 
-#ifdef __clang__
-#pragma clang diagnostic push
-#pragma clang diagnostic ignored "-Wdeprecated-declarations" // sprintf is deprecated in Xcode14.1 RC
-#endif
-#include <boost/lexical_cast.hpp>
-#ifdef __clang__
-#pragma clang diagnostic pop
-#endif
+#include <array>
+#include <bit>
+#include <cerrno>
+#include <charconv>
+#include <clocale>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
 
 namespace tc {
 	///////////////
 	// Wrapper to print integers as decimal
 
-	namespace integral_as_padded_dec_adl {
-		template< typename T, std::size_t N>
-		struct integral_as_padded_dec_impl;
-
-		template< typename T>
-		struct integral_as_padded_dec_impl<T,1>;
+	namespace integral_as_padded_dec_detail {
+		inline constexpr char c_achDigitPairs[] =
+			"0001020304050607080910111213141516171819"
+			"2021222324252627282930313233343536373839"
+			"4041424344454647484950515253545556575859"
+			"6061626364656667686970717273747576777879"
+			"8081828384858687888990919293949596979899";
+
+		// Writes the decimal digits of n backwards, ending in front of pch, two digits per division. Returns the first digit.
+		template<typename U>
+		constexpr tc::char_ascii* format_backwards(U n, tc::char_ascii* pch) noexcept {
+			static_assert( std::is_unsigned<U>::value );
+			while( 100 <= n ) {
+				auto const i = tc::explicit_cast<std::size_t>(n % 100) * 2;
+				n /= 100;
+				*--pch = tc::char_ascii(c_achDigitPairs[i + 1]);
+				*--pch = tc::char_ascii(c_achDigitPairs[i]);
+			}
+			if( 10 <= n ) {
+				auto const i = tc::explicit_cast<std::size_t>(n) * 2;
+				*--pch = tc::char_ascii(c_achDigitPairs[i + 1]);
+				*--pch = tc::char_ascii(c_achDigitPairs[i]);
+			} else {
+				*--pch = tc::char_ascii('0') + n;
+			}
+			return pch;
+		}
+	}
 
+	namespace integral_as_padded_dec_adl {
 		template< typename T, std::size_t N>
-		struct [[nodiscard]] integral_as_padded_dec_impl : protected integral_as_padded_dec_impl<T,N-1> {
+		struct [[nodiscard]] integral_as_padded_dec_impl final {
 			friend auto range_output_t_impl(integral_as_padded_dec_impl const&) -> tc::type::list<tc::char_ascii>; // declaration only
-			static constexpr unsigned long long c_nTenPow=integral_as_padded_dec_impl<T,N-1>::c_nTenPow*10;
-			constexpr integral_as_padded_dec_impl( T n ) noexcept : integral_as_padded_dec_impl<T,N-1>(n) {}
-
-			template<typename Sink>
-			auto operator()(Sink sink) const& MAYTHROW -> tc::common_type_t<
-				decltype(tc::continue_if_not_break(std::declval<Sink&>(), std::declval<tc::char_ascii>())),
-				decltype(std::declval<integral_as_padded_dec_impl<T,N-1> const&>()(std::declval<Sink>()))
-			> {
-				static_assert( std::is_unsigned<T>::value );
-				if( this->m_n<integral_as_padded_dec_impl::c_nTenPow ) {
-					tc_yield(sink, tc::char_ascii('0'));
-				}
-				return tc::base_cast< integral_as_padded_dec_impl<T,N-1> >(*this)(tc_move(sink));
-			}
+		private:
+			// promote to at least unsigned int, otherwise unsigned/signed char arithmetic is done in int
+			using unsigned_type = std::conditional_t<sizeof(T) <= sizeof(unsigned int), unsigned int, std::make_unsigned_t<T>>;
+			T m_n;
 
-			constexpr bool empty() const& noexcept { return false; }
-		};
+		public:
+			static constexpr std::size_t c_nMaxSize = tc::max(N, tc::explicit_cast<std::size_t>(std::numeric_limits<T>::digits10) + 1) + (std::is_signed<T>::value ? 1 : 0);
 
-		template< typename T>
-		struct [[nodiscard]] integral_as_padded_dec_impl<T,1> {
-			friend auto range_output_t_impl(integral_as_padded_dec_impl const&) -> tc::type::list<tc::char_ascii>; // declaration only
-			T m_n;
-			static constexpr unsigned long long c_nTenPow=1;
 			constexpr integral_as_padded_dec_impl( T n ) noexcept : m_n(n) {}
 
+			// The digits are formatted into a buffer and passed to the sink as one chunk.
 			template<typename Sink>
 			auto operator()(Sink&& sink) const& MAYTHROW {
-				return tc::for_each(tc::transform(tc::ptr_begin( boost::lexical_cast< std::array<char,50> >(m_n+0/*force integral promotion, otherwise unsigned/signed char gets printed as character*/) ), tc::fn_explicit_cast<tc::char_ascii>()), std::forward<Sink>(sink));
+				std::array<tc::char_ascii, c_nMaxSize> ach;
+				tc::char_ascii* const pchEnd = ach.data() + c_nMaxSize;
+				bool const bNegative = [&]() noexcept {
+					if constexpr( std::is_signed<T>::value ) {
+						return m_n < 0;
+					} else {
+						return false;
+					}
+				}();
+				auto const nAbs = static_cast<unsigned_type>(m_n);
+				tc::char_ascii* pch = integral_as_padded_dec_detail::format_backwards(bNegative ? unsigned_type(0) - nAbs : nAbs, pchEnd);
+				while( tc::explicit_cast<std::size_t>(pchEnd - pch) < N ) {
+					*--pch = tc::char_ascii('0');
+				}
+				if( bNegative ) {
+					*--pch = tc::char_ascii('-');
+				}
+				return tc::for_each(tc::make_iterator_range(pch, pchEnd), std::forward<Sink>(sink));
 			}
 
 			constexpr bool empty() const& noexcept { return false; }
@@ -97,6 +131,121 @@ namespace tc {
 		tc::as_padded_dec<N>(t.m_t)
 	)
 
+	///////////////
+	// Wrapper to print floating point numbers as decimal
+
+	namespace floating_point_as_dec_detail {
+		template<std::floating_point T>
+		T strto(char const* const psz) noexcept {
+			if constexpr( std::is_same<T, float>::value ) {
+				return std::strtof(psz, nullptr);
+			} else if constexpr( std::is_same<T, double>::value ) {
+				return std::strtod(psz, nullptr);
+			} else {
+				return std::strtold(psz, nullptr);
+			}
+		}
+
+		// Prints f to psz like "%.*e" or "%.*f" in the current locale and returns the length.
+		template<std::floating_point T>
+		std::size_t print(char* const psz, std::size_t const nSize, bool const bScientific, int const nPrecision, T const f) noexcept {
+			int nLength;
+			if constexpr( std::is_same<T, long double>::value ) {
+				nLength = std::snprintf(psz, nSize, bScientific ? "%.*Le" : "%.*Lf", nPrecision, f);
+			} else {
+				nLength = std::snprintf(psz, nSize, bScientific ? "%.*e" : "%.*f", nPrecision, static_cast<double>(f));
+			}
+			_ASSERT(0 < nLength && tc::explicit_cast<std::size_t>(nLength) < nSize);
+			return tc::explicit_cast<std::size_t>(nLength);
+		}
+
+		// Same output as std::to_chars(pchBegin, pchBegin + nSize, f), for standard libraries without floating point support in <charconv>:
+		// the correctly rounded significand with the fewest digits that parses back to f is also the one std::to_chars prints.
+		template<std::floating_point T>
+		char* to_chars(char* const pchBegin, std::size_t const nSize, T const f) noexcept {
+			auto const Copy = [&](char const* psz) noexcept {
+				char const* const pszDecimalPoint = std::localeconv()->decimal_point;
+				auto const nDecimalPoint = std::strlen(pszDecimalPoint);
+				auto pch = pchBegin;
+				while( *psz ) {
+					_ASSERT(pch != pchBegin + nSize);
+					if( 0 == std::strncmp(psz, pszDecimalPoint, nDecimalPoint) ) {
+						*pch = '.';
+						psz += nDecimalPoint;
+					} else {
+						*pch = *psz;
+						++psz;
+					}
+					++pch;
+				}
+				return pch;
+			};
+			if( std::isnan(f) ) return Copy(std::signbit(f) ? "-nan" : "nan");
+			if( std::isinf(f) ) return Copy(std::signbit(f) ? "-inf" : "inf");
+
+			std::array<char, std::numeric_limits<T>::max_digits10 + 32> ach;
+			int nDigits = 1;
+			for( ; nDigits < std::numeric_limits<T>::max_digits10; ++nDigits ) {
+				print(ach.data(), ach.size(), /*bScientific*/true, nDigits - 1, f);
+				if( strto<T>(ach.data()) == f ) break;
+			}
+			print(ach.data(), ach.size(), /*bScientific*/true, nDigits - 1, f);
+			auto const pchEndScientific = Copy(ach.data());
+			auto const nExponent = std::atoi(std::strchr(ach.data(), 'e') + 1);
+			int const nDecimals = tc::max(0, nDigits - 1 - nExponent);
+			if( (std::signbit(f) ? 1 : 0) + (0 <= nExponent ? nExponent + 1 : 1) + (0 < nDecimals ? 1 + nDecimals : 0) <= pchEndScientific - pchBegin ) { // std::to_chars prefers fixed notation if both are equally long
+				print(ach.data(), ach.size(), /*bScientific*/false, nDecimals, f);
+				return Copy(ach.data());
+			} else {
+				return pchEndScientific;
+			}
+		}
+	}
+
+	namespace floating_point_as_dec_adl {
+		// Prints the shortest decimal representation that parses back to the same value, in fixed or scientific notation,
+		// whichever is shorter, like std::to_chars.
+		template<std::floating_point T>
+		struct [[nodiscard]] floating_point_as_dec_impl final {
+			friend auto range_output_t_impl(floating_point_as_dec_impl const&) -> tc::type::list<tc::char_ascii>; // declaration only
+		private:
+			T m_f;
+
+		public:
+			// sign, significant digits, decimal point, "e-" and exponent
+			static constexpr std::size_t c_nMaxSize = 1 + std::numeric_limits<T>::max_digits10 + 1 + 2 + 4;
+
+			constexpr floating_point_as_dec_impl( T f ) noexcept : m_f(f) {}
+
+			template<typename Sink>
+			auto operator()(Sink&& sink) const& MAYTHROW {
+				std::array<char, c_nMaxSize> ach;
+#ifdef __cpp_lib_to_chars
+				auto const result = std::to_chars(ach.data(), ach.data() + c_nMaxSize, m_f);
+				_ASSERTEQUAL(result.ec, std::errc());
+				auto const pchEnd = result.ptr;
+#else // e.g., libc++
+				auto const pchEnd = floating_point_as_dec_detail::to_chars(ach.data(), c_nMaxSize, m_f);
+#endif
+
+				std::array<tc::char_ascii, c_nMaxSize> achAscii;
+				auto const nSize = tc::explicit_cast<std::size_t>(pchEnd - ach.data());
+				for( std::size_t i = 0; i < nSize; ++i ) {
+					achAscii[i] = tc::char_ascii(ach[i]);
+				}
+				return tc::for_each(tc::make_iterator_range(achAscii.data(), achAscii.data() + nSize), std::forward<Sink>(sink));
+			}
+
+			constexpr bool empty() const& noexcept { return false; }
+		};
+	}
+
+	template< std::floating_point T>
+	constexpr auto as_dec(T t) return_ctor_noexcept(
+		floating_point_as_dec_adl::floating_point_as_dec_impl<T>,
+		(t)
+	)
+
 	TC_DEFINE_ENUM(casing, BOOST_PP_EMPTY(), (uppercase)(lowercase));
 
 	namespace as_hex_adl {
@@ -108,6 +257,8 @@ namespace tc {
 		private:
 			typename boost::uint_t< CHAR_BIT*sizeof(T) >::exact m_n;
 		public:
+			static constexpr std::size_t c_nMaxSize = (sizeof(m_n)*CHAR_BIT+3)/4;
+
 			constexpr as_hex_impl( T const& n ) noexcept : m_n(tc::bit_cast< typename boost::uint_t< CHAR_BIT*sizeof(T) >::exact >(n)) {} // print the bit pattern of anything we get
 
 			template<typename Sink>
@@ -155,48 +306,363 @@ namespace tc {
 		(t)
 	)
 
+	///////////////
+	// Format strings parsed at compile time
+
+	namespace format_detail {
+		// A piece of the format string is either the literal [m_nBegin, m_nEnd) or the argument m_nArg.
+		struct piece final {
+			std::size_t m_nBegin = 0;
+			std::size_t m_nEnd = 0;
+			std::size_t m_nArg = 0;
+			bool m_bArg = false;
+		};
+
+		template<std::size_t N>
+		struct parsed_format final {
+			std::array<piece, N> m_apiece{};
+			std::size_t m_npiece = 0;
+			std::size_t m_nArgs = 0;
+			std::size_t m_nLiteralSize = 0;
+			bool m_bValid = true;
+		};
+
+		// "{}" is replaced by the next argument, "{{" and "}}" print a single brace.
+		template<typename Char, std::size_t N>
+		consteval auto parse(tc::string_template_param<Char, N> const& str) noexcept {
+			parsed_format<N> parsed; // N-1 characters form at most N-1 pieces
+			auto const AppendLiteral = [&](std::size_t const nBegin, std::size_t const nEnd) noexcept {
+				if( nBegin != nEnd ) {
+					parsed.m_apiece[parsed.m_npiece++] = piece{nBegin, nEnd, 0, false};
+					parsed.m_nLiteralSize += nEnd - nBegin;
+				}
+			};
+			std::size_t nBegin = 0;
+			std::size_t i = 0;
+			while( i < N-1 ) {
+				if( Char('{') == str.m_str[i] || Char('}') == str.m_str[i] ) {
+					if( i + 1 < N-1 && str.m_str[i] == str.m_str[i+1] ) {
+						AppendLiteral(nBegin, i + 1);
+					} else if( Char('{') == str.m_str[i] && i + 1 < N-1 && Char('}') == str.m_str[i+1] ) {
+						AppendLiteral(nBegin, i);
+						parsed.m_apiece[parsed.m_npiece++] = piece{0, 0, parsed.m_nArgs++, true};
+					} else {
+						parsed.m_bValid = false;
+						break;
+					}
+					i += 2;
+					nBegin = i;
+				} else {
+					++i;
+				}
+			}
+			AppendLiteral(nBegin, N-1);
+			return parsed;
+		}
+	}
+
+	namespace format_adl {
+		// Generator range of the format string Fmt with its placeholders replaced by the arguments. The literal pieces are passed
+		// to the sink as chunks. Its size_upper_bound lets tc::append reserve memory once if all arguments have a size or a bound.
+		template<tc::string_template_param Fmt, typename... Args>
+		struct [[nodiscard]] format_impl final {
+		private:
+			using char_type = typename decltype(Fmt)::value_type;
+			static constexpr auto c_parsed = format_detail::parse(Fmt);
+			static_assert( c_parsed.m_bValid, "Braces must be escaped as {{ and }}, placeholders must be {}." );
+			static_assert( c_parsed.m_nArgs == sizeof...(Args), "The number of arguments must match the number of placeholders." );
+
+			tc::tuple<tc::range_adaptor_base_range<Args>...> m_tupleadaptbaserng;
+
+		public:
+			template<typename... Rhs>
+			constexpr format_impl(tc::aggregate_tag_t, Rhs&&... rhs) noexcept
+				: m_tupleadaptbaserng{{ {{tc::aggregate_tag, std::forward<Rhs>(rhs)}}... }}
+			{}
+
+			friend auto range_output_t_impl(format_impl const&) -> tc::type::unique_t<tc::type::concat_t<
+				tc::type::list<char_type const&>,
+				tc::range_output_t<decltype(std::declval<tc::range_adaptor_base_range<Args> const&>().base_range())>...
+			>>; // declaration only
+
+			template<typename Sink>
+			constexpr auto operator()(Sink const& sink) const& MAYTHROW {
+				return tc::for_each(std::make_index_sequence<c_parsed.m_npiece>(), [&](auto const nconstIndex) MAYTHROW {
+					constexpr format_detail::piece c_piece = c_parsed.m_apiece[nconstIndex()];
+					if constexpr( c_piece.m_bArg ) {
+						return tc::for_each(tc::get<c_piece.m_nArg>(m_tupleadaptbaserng).base_range(), sink); // MAYTHROW
+					} else {
+						return tc::for_each(tc::make_iterator_range(Fmt.m_str + c_piece.m_nBegin, Fmt.m_str + c_piece.m_nEnd), sink); // MAYTHROW
+					}
+				});
+			}
+
+			constexpr auto size_upper_bound() const& MAYTHROW requires (... && tc::has_size_upper_bound<decltype(std::declval<tc::range_adaptor_base_range<Args> const&>().base_range())>) {
+				return tc::apply(
+					[](auto const&... adaptbaserng) MAYTHROW {
+						return (c_parsed.m_nLiteralSize + ... + tc::explicit_cast<std::size_t>(tc::size_upper_bound(adaptbaserng.base_range())));
+					},
+					m_tupleadaptbaserng
+				);
+			}
+		};
+	}
+
+	// tc::format<"({}, {})">(tc::as_dec(x), tc::as_dec(y)) is equivalent to tc::concat("(", tc::as_dec(x), ", ", tc::as_dec(y), ")"),
+	// but the format string is checked at compile time.
+	template<tc::string_template_param Fmt, typename... Args>
+	constexpr auto format(Args&&... args) return_ctor_noexcept(
+		TC_FWD(format_adl::format_impl<Fmt, Args...>),
+		(tc::aggregate_tag, std::forward<Args>(args)...)
+	)
+
 	//////////////////////////////////////////////////
 	// conversion from string to number
 
+	namespace integer_from_string_detail {
+		template<typename Rng>
+		concept contiguous_char_range = tc::contiguous_range<Rng> && tc::common_range<Rng> && std::is_same<tc::range_value_t<Rng>, char>::value;
+
+		// Number of leading decimal digits in the 8 code units of n, loaded on a little endian machine.
+		inline int count_digits_swar(std::uint64_t const n) noexcept {
+			// A byte is a digit iff its high nibble is 3, also after adding 6. A carry out of a byte only affects the bytes behind a non-digit.
+			std::uint64_t const nNonDigit = ((n & 0xf0f0f0f0f0f0f0f0) ^ 0x3030303030303030) | (((n + 0x0606060606060606) & 0xf0f0f0f0f0f0f0f0) ^ 0x3030303030303030);
+			return 0 == nNonDigit ? 8 : std::countr_zero(nNonDigit) / 8;
+		}
+
+		// Value of the 8 decimal digits in n, the first digit in the lowest byte.
+		inline std::uint64_t parse_8_digits_swar(std::uint64_t n) noexcept {
+			n -= 0x3030303030303030;
+			n = (n * 10 + (n >> 8)) & 0x00ff00ff00ff00ff; // pairs of digits
+			n = (n * 100 + (n >> 16)) & 0x0000ffff0000ffff; // groups of 4 digits
+			return (n * 10000 + (n >> 32)) & 0x00000000ffffffff;
+		}
+
+		// Parses digits while the value does not exceed nLimit. As long as 8 more digits cannot exceed nLimit, they are parsed at once.
+		template<typename U>
+		std::pair<U, char const*> parse_digits(char const* pch, char const* const pchEnd, U const nLimit) noexcept {
+			static_assert( std::is_unsigned<U>::value );
+			U n = 0;
+			if constexpr( 99999999 <= std::numeric_limits<U>::max() && std::endian::little == std::endian::native ) {
+				if( 99999999 <= nLimit ) {
+					U const nLimitSwar = (nLimit - 99999999) / 100000000;
+					while( 8 <= pchEnd - pch && n <= nLimitSwar ) {
+						std::uint64_t nDigits;
+						std::memcpy(&nDigits, pch, sizeof(nDigits));
+						if( 8 != integer_from_string_detail::count_digits_swar(nDigits) ) break;
+						n = n * 100000000 + static_cast<U>(integer_from_string_detail::parse_8_digits_swar(nDigits));
+						pch += 8;
+					}
+				}
+			}
+			for( ; pch != pchEnd; ++pch ) {
+				unsigned int const nDigit = static_cast<unsigned char>(*pch) - static_cast<unsigned int>('0');
+				if( 9 < nDigit || (nLimit - nDigit) / 10 < n ) break; // overflow
+				n = static_cast<U>(n * 10 + nDigit);
+			}
+			return std::make_pair(n, pch);
+		}
+
+		template<typename T, typename Rng>
+		auto pack(Rng&& rng, T const t, char const* const pch) noexcept {
+			return std::make_pair(t, tc::begin(rng) + (pch - std::to_address(tc::begin(rng))));
+		}
+	}
+
 	template< typename T, typename Rng >
 	auto unsigned_integer_from_string_head(Rng&& rng) noexcept {
-		auto pairnit=std::make_pair(tc::explicit_cast<T>(0),tc::begin(rng));
-		auto const itEnd=tc::end(rng);
-		while( pairnit.second!=itEnd ) {
-			unsigned int const nDigit=*pairnit.second-tc::explicit_cast<tc::range_value_t<Rng&>>('0');
-			if( 9<nDigit || (std::numeric_limits<T>::max()-static_cast<int>(nDigit))/10<pairnit.first ) break; // overflow
-			pairnit.first*=10;
+		if constexpr( integer_from_string_detail::contiguous_char_range<Rng> && tc::actual_integer<T> ) {
+			using U = std::make_unsigned_t<T>;
+			auto const pairnpch = integer_from_string_detail::parse_digits<U>(std::to_address(tc::begin(rng)), std::to_address(tc::end(rng)), static_cast<U>(std::numeric_limits<T>::max()));
+			return integer_from_string_detail::pack(rng, static_cast<T>(pairnpch.first), pairnpch.second);
+		} else {
+			auto pairnit=std::make_pair(tc::explicit_cast<T>(0),tc::begin(rng));
+			auto const itEnd=tc::end(rng);
+			while( pairnit.second!=itEnd ) {
+				unsigned int const nDigit=*pairnit.second-tc::explicit_cast<tc::range_value_t<Rng&>>('0');
+				if( 9<nDigit || (std::numeric_limits<T>::max()-static_cast<int>(nDigit))/10<pairnit.first ) break; // overflow
+				pairnit.first*=10;
 MODIFY_WARNINGS_BEGIN(((disable)(4244))) // conversion from 'const unsigned int' to 'uint16_t', possible loss of data
-			pairnit.first+=nDigit;
+				pairnit.first+=nDigit;
 MODIFY_WARNINGS_END
-			++pairnit.second;
+				++pairnit.second;
+			}
+			return pairnit;
 		}
-		return pairnit;
 	}
 
 	template< typename T, typename Rng >
 	auto signed_integer_from_string_head(Rng&& rng) noexcept {
-		auto pairnit=std::make_pair(tc::explicit_cast<T>(0),tc::begin(rng));
-		auto const itEnd=tc::end(rng);
-		if( pairnit.second!=itEnd ) {
-			if (tc::explicit_cast<tc::range_value_t<Rng&>>('-') == *pairnit.second) {
-				++pairnit.second;
-				while (pairnit.second != itEnd) {
-					unsigned int const nDigit = *pairnit.second - tc::explicit_cast<tc::range_value_t<Rng&>>('0');
-					if (9 < nDigit || pairnit.first < (std::numeric_limits<T>::lowest() + static_cast<int>(nDigit)) / 10) break; // underflow
-					pairnit.first *= 10;
+		if constexpr( integer_from_string_detail::contiguous_char_range<Rng> && tc::actual_integer<T> && std::is_signed<T>::value ) {
+			auto const pchBegin = std::to_address(tc::begin(rng));
+			auto const pchEnd = std::to_address(tc::end(rng));
+			using U = std::make_unsigned_t<T>;
+			if( pchBegin != pchEnd && '-' == *pchBegin ) {
+				auto const pairnpch = integer_from_string_detail::parse_digits<U>(pchBegin + 1, pchEnd, static_cast<U>(U(0) - static_cast<U>(std::numeric_limits<T>::lowest())));
+				return integer_from_string_detail::pack(rng, static_cast<T>(U(0) - pairnpch.first), pairnpch.second);
+			} else {
+				auto const pchDigits = pchBegin != pchEnd && '+' == *pchBegin ? pchBegin + 1 : pchBegin;
+				auto const pairnpch = integer_from_string_detail::parse_digits<U>(pchDigits, pchEnd, static_cast<U>(std::numeric_limits<T>::max()));
+				return integer_from_string_detail::pack(rng, static_cast<T>(pairnpch.first), pairnpch.second);
+			}
+		} else {
+			auto pairnit=std::make_pair(tc::explicit_cast<T>(0),tc::begin(rng));
+			auto const itEnd=tc::end(rng);
+			if( pairnit.second!=itEnd ) {
+				if (tc::explicit_cast<tc::range_value_t<Rng&>>('-') == *pairnit.second) {
+					++pairnit.second;
+					while (pairnit.second != itEnd) {
+						unsigned int const nDigit = *pairnit.second - tc::explicit_cast<tc::range_value_t<Rng&>>('0');
+						if (9 < nDigit || pairnit.first < (std::numeric_limits<T>::lowest() + static_cast<int>(nDigit)) / 10) break; // underflow
+						pairnit.first *= 10;
 MODIFY_WARNINGS_BEGIN(((disable)(4244))) // conversion from 'const unsigned int' to 'uint16_t', possible loss of data
-					pairnit.first -= nDigit;
+						pairnit.first -= nDigit;
 MODIFY_WARNINGS_END
-					++pairnit.second;
+						++pairnit.second;
+					}
+				} else if (tc::explicit_cast<tc::range_value_t<Rng&>>('+') == *pairnit.second) {
+					pairnit = unsigned_integer_from_string_head<T>(tc::begin_next<tc::return_drop>(rng));
+				} else {
+					pairnit = unsigned_integer_from_string_head<T>(rng);
 				}
-			} else if (tc::explicit_cast<tc::range_value_t<Rng&>>('+') == *pairnit.second) {
-				pairnit = unsigned_integer_from_string_head<T>(tc::begin_next<tc::return_drop>(rng));
-			} else {
-				pairnit = unsigned_integer_from_string_head<T>(rng);
 			}
+			return pairnit;
+		}
+	}
+
+	namespace floating_point_from_string_detail {
+		// Longest input copied from ranges that are not contiguous char ranges, enough for any number tc::as_dec prints.
+		inline constexpr std::size_t c_nMaxCopy = 128;
+
+		// Same result as std::from_chars(pchBegin, pchEnd, f) in std::chars_format::general, for standard libraries without floating point support in <charconv>.
+		// Returns pchBegin if there is no number or it is out of range of T.
+		template< std::floating_point T >
+		std::pair<T, char const*> strto_chars(char const* const pchBegin, char const* const pchEnd) noexcept {
+			auto const StartsWith = [&](char const* pch, char const* psz) noexcept {
+				for( ; *psz; ++pch, ++psz ) {
+					if( pch == pchEnd || (*pch | 0x20) != *psz ) return false; // case insensitive for letters
+				}
+				return true;
+			};
+			auto const IsDigit = [](char const ch) noexcept { return '0' <= ch && ch <= '9'; };
+
+			auto pch = pchBegin;
+			bool const bNegative = pch != pchEnd && '-' == *pch;
+			if( bNegative ) ++pch;
+			auto const Signed = [&](T const f) noexcept { return bNegative ? -f : f; };
+			if( StartsWith(pch, "inf") ) {
+				return std::make_pair(Signed(std::numeric_limits<T>::infinity()), pch + (StartsWith(pch, "infinity") ? 8 : 3));
+			}
+			if( StartsWith(pch, "nan") ) {
+				pch += 3;
+				if( pch != pchEnd && '(' == *pch ) {
+					auto pchSequence = pch + 1;
+					while( pchSequence != pchEnd && ('_' == *pchSequence || IsDigit(*pchSequence) || ('a' <= (*pchSequence | 0x20) && (*pchSequence | 0x20) <= 'z')) ) ++pchSequence;
+					if( pchSequence != pchEnd && ')' == *pchSequence ) pch = pchSequence + 1;
+				}
+				return std::make_pair(Signed(std::numeric_limits<T>::quiet_NaN()), pch);
+			}
+
+			auto const pchMantissa = pch;
+			while( pch != pchEnd && IsDigit(*pch) ) ++pch;
+			auto const pchDecimalPoint = pch;
+			bool const bDecimalPoint = pch != pchEnd && '.' == *pch;
+			if( bDecimalPoint ) {
+				++pch;
+				while( pch != pchEnd && IsDigit(*pch) ) ++pch;
+			}
+			auto const pchMantissaEnd = pch;
+			if( pch - pchMantissa == (bDecimalPoint ? 1 : 0) ) return std::make_pair(tc::explicit_cast<T>(0), pchBegin); // no digits
+			long long nExponent = 0; // saturated far beyond the range of T
+			if( pch != pchEnd && 'e' == (*pch | 0x20) ) {
+				auto pchExponent = pch + 1;
+				bool const bNegativeExponent = pchExponent != pchEnd && '-' == *pchExponent;
+				if( pchExponent != pchEnd && ('+' == *pchExponent || '-' == *pchExponent) ) ++pchExponent;
+				if( pchExponent != pchEnd && IsDigit(*pchExponent) ) {
+					for( pch = pchExponent; pch != pchEnd && IsDigit(*pch); ++pch ) {
+						nExponent = tc::min(nExponent * 10 + (*pch - '0'), 1000000000ll);
+					}
+					if( bNegativeExponent ) nExponent = -nExponent;
+				}
+			}
+
+			// strtod needs a zero-terminated string, which is written without a decimal point, which would depend on the locale,
+			// as significant digits * 10^nExponent. Digits beyond the most that a value halfway between two adjacent values of T
+			// can have do not change the rounding, only whether they are all zero, so they are replaced by a single 1.
+			static constexpr std::size_t c_nMaxDigits = ((std::numeric_limits<T>::digits + 1) * 30103ull + (std::numeric_limits<T>::digits - std::numeric_limits<T>::min_exponent + 1) * 69897ull) / 100000 + 2;
+			std::array<char, 1 + c_nMaxDigits + 1 + 1 + 20 + 1> ach; // sign, digits, sticky digit, 'e', exponent, zero terminator
+			auto pchDst = ach.data();
+			if( bNegative ) *pchDst++ = '-';
+			auto const pchDigits = pchDst;
+			bool bDropped = false;
+			for( auto pchSrc = pchMantissa; pchSrc != pchMantissaEnd; ++pchSrc ) {
+				if( pchSrc == pchDecimalPoint ) continue;
+				if( pchDecimalPoint < pchSrc ) --nExponent;
+				if( pchDigits == pchDst && '0' == *pchSrc ) continue; // leading zero
+				if( tc::explicit_cast<std::size_t>(pchDst - pchDigits) < c_nMaxDigits ) {
+					*pchDst++ = *pchSrc;
+				} else {
+					++nExponent;
+					bDropped = bDropped || '0' != *pchSrc;
+				}
+			}
+			if( pchDigits == pchDst ) {
+				*pchDst++ = '0';
+			} else if( bDropped ) {
+				*pchDst++ = '1';
+				--nExponent;
+			}
+			std::snprintf(pchDst, tc::explicit_cast<std::size_t>(ach.data() + ach.size() - pchDst), "e%lld", nExponent);
+			errno = 0;
+			T const f = floating_point_as_dec_detail::strto<T>(ach.data());
+			if( ERANGE == errno && (0 == f || std::isinf(f)) ) return std::make_pair(tc::explicit_cast<T>(0), pchBegin); // out of range, but subnormal numbers are not
+			return std::make_pair(f, pch);
+		}
+
+		template< typename T >
+		std::pair<T, char const*> from_chars(char const* const pchBegin, char const* const pchEnd) noexcept {
+			auto const pchNumber = pchBegin != pchEnd && '+' == *pchBegin ? pchBegin + 1 : pchBegin; // std::from_chars does not accept '+'
+			if( pchNumber == pchBegin || (pchNumber != pchEnd && '-' != *pchNumber) ) {
+#ifdef __cpp_lib_to_chars
+				T f;
+				if( auto const result = std::from_chars(pchNumber, pchEnd, f); std::errc() == result.ec ) {
+					return std::make_pair(f, result.ptr);
+				}
+#else // e.g., libc++
+				if( auto const pairfpch = strto_chars<T>(pchNumber, pchEnd); pchNumber != pairfpch.second ) {
+					return pairfpch;
+				}
+#endif
+			}
+			return std::make_pair(tc::explicit_cast<T>(0), pchBegin); // no number or out of range
+		}
+	}
+
+	// Parses the longest prefix of rng that is a decimal floating point number, including "inf" and "nan", like strtod in the "C" locale.
+	// Values out of range of T are not parsed, nor are numbers longer than c_nMaxCopy in ranges other than contiguous char ranges. Returns the value and the end of the parsed prefix, which is tc::begin(rng) if nothing was parsed.
+	template< std::floating_point T, typename Rng >
+	auto floating_point_from_string_head(Rng&& rng) noexcept {
+		if constexpr( tc::contiguous_range<Rng> && tc::common_range<Rng> && std::is_same<tc::range_value_t<Rng>, char>::value ) {
+			auto const pchBegin = std::to_address(tc::begin(rng));
+			auto const pairfpch = floating_point_from_string_detail::from_chars<T>(pchBegin, std::to_address(tc::end(rng)));
+			return std::make_pair(pairfpch.first, tc::begin(rng) + (pairfpch.second - pchBegin));
+		} else {
+			// Copy the characters that may be part of a number into a buffer.
+			std::array<char, floating_point_from_string_detail::c_nMaxCopy> ach{};
+			std::size_t nCopied = 0;
+			auto it = tc::begin(rng);
+			auto const itEnd = tc::end(rng);
+			for( ; it != itEnd && nCopied < ach.size(); ++it, ++nCopied ) {
+				auto const n = tc::to_underlying(*it);
+				if( n < 0x21 || 0x7e < n ) break; // nothing outside of printable ASCII is part of a number
+				ach[nCopied] = static_cast<char>(n);
+			}
+			auto pairfpch = floating_point_from_string_detail::from_chars<T>(ach.data(), ach.data() + nCopied);
+			if( ach.data() + ach.size() == pairfpch.second && it != itEnd ) { // the number may continue beyond the buffer
+				pairfpch = std::make_pair(tc::explicit_cast<T>(0), ach.data());
+			}
+			return std::make_pair(pairfpch.first, std::next(tc::begin(rng), pairfpch.second - ach.data()));
 		}
-		return pairnit;
 	}
 
 	struct integer_parse_exception final {};
@@ -217,6 +683,47 @@ MODIFY_WARNINGS_END
 		return pairnit.first;
 	}
 
+	// Parses a list of integers separated by chDelimiter, e.g., a column of a CSV file.
+	template< typename T, typename Rng >
+	tc::vector<T> integers_from_delimited_string( Rng const& rng, tc::range_value_t<Rng const&> const chDelimiter ) THROW(tc::integer_parse_exception) {
+		auto const Parse = [&](auto it, auto const itEnd) THROW(tc::integer_parse_exception) {
+			tc::vector<T> vecn;
+			if( it != itEnd ) {
+				for(;;) {
+					auto const pairnit = [&]() noexcept {
+						if constexpr( std::is_signed<T>::value ) {
+							return tc::signed_integer_from_string_head<T>(tc::make_iterator_range(it, itEnd));
+						} else {
+							return tc::unsigned_integer_from_string_head<T>(tc::make_iterator_range(it, itEnd));
+						}
+					}();
+					if( pairnit.second == it ) throw tc::integer_parse_exception();
+					tc::cont_emplace_back(vecn, pairnit.first);
+					it = pairnit.second;
+					if( it == itEnd ) break;
+					if( *it != chDelimiter ) throw tc::integer_parse_exception();
+					++it;
+				}
+			}
+			return vecn;
+		};
+		if constexpr( integer_from_string_detail::contiguous_char_range<Rng const&> ) {
+			return Parse(std::to_address(tc::begin(rng)), std::to_address(tc::end(rng))); // parse pointer ranges with the fast path
+		} else {
+			return Parse(tc::begin(rng), tc::end(rng));
+		}
+	}
+
+	struct floating_point_parse_exception final {};
+
+	template< std::floating_point T, typename Rng >
+	T floating_point_from_string( Rng const& rng ) THROW(tc::floating_point_parse_exception) {
+		if (tc::empty(rng)) throw tc::floating_point_parse_exception();
+		auto pairfit=tc::floating_point_from_string_head<T>(rng);
+		if( pairfit.second!=tc::end(rng) ) throw tc::floating_point_parse_exception();
+		return pairfit.first;
+	}
+
 	namespace no_adl {
 		template<typename Rng>
 		struct [[nodiscard]] size_prefixed_impl : private tc::range_adaptor_base_range<Rng> {
@@ -0,0 +1,233 @@
+// think-cell public library
+//
+// Copyright (C) 2016-2023 think-cell Software GmbH
+//
+// Distributed under the Boost Software License, Version 1.0.
+// See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt
+
+#include "../base/assert_defs.h"
+#include "../unittest.h"
+#include "../algorithm/append.h"
+#include "../range/filter_adaptor.h"
+#include "format.h"
+
+#include <array>
+#include <charconv>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <string>
+
+UNITTESTDEF(as_dec) {
+	_ASSERTEQUAL(tc::make_str<char>(tc::as_dec(0)), "0");
+	_ASSERTEQUAL(tc::make_str<char>(tc::as_dec(7)), "7");
+	_ASSERTEQUAL(tc::make_str<char>(tc::as_dec(10)), "10");
+	_ASSERTEQUAL(tc::make_str<char>(tc::as_dec(-99)), "-99");
+	_ASSERTEQUAL(tc::make_str<char>(tc::as_dec(100)), "100");
+	_ASSERTEQUAL(tc::make_str<char>(tc::as_dec(std::numeric_limits<std::int8_t>::lowest())), "-128");
+	_ASSERTEQUAL(tc::make_str<char>(tc::as_dec(std::numeric_limits<std::uint8_t>::max())), "255");
+	_ASSERTEQUAL(tc::make_str<char>(tc::as_dec(std::numeric_limits<std::int16_t>::lowest())), "-32768");
+	_ASSERTEQUAL(tc::make_str<char>(tc::as_dec(std::numeric_limits<std::int32_t>::lowest())), "-2147483648");
+	_ASSERTEQUAL(tc::make_str<char>(tc::as_dec(std::numeric_limits<std::uint32_t>::max())), "4294967295");
+	_ASSERTEQUAL(tc::make_str<char>(tc::as_dec(std::numeric_limits<std::int64_t>::lowest())), "-9223372036854775808");
+	_ASSERTEQUAL(tc::make_str<char>(tc::as_dec(std::numeric_limits<std::int64_t>::max())), "9223372036854775807");
+	_ASSERTEQUAL(tc::make_str<char>(tc::as_dec(std::numeric_limits<std::uint64_t>::max())), "18446744073709551615");
+
+	for( std::int64_t n = -100000; n <= 100000; n += 7 ) {
+		_ASSERT(tc::equal(tc::make_str<char>(tc::as_dec(n)), std::to_string(n)));
+	}
+	for( std::uint64_t n = 1; n < std::numeric_limits<std::uint64_t>::max() / 3; n = n * 3 + 1 ) {
+		_ASSERT(tc::equal(tc::make_str<char>(tc::as_dec(n)), std::to_string(n)));
+	}
+
+	_ASSERTEQUAL(tc::make_str<char>(tc::as_padded_dec<3>(7)), "007");
+	_ASSERTEQUAL(tc::make_str<char>(tc::as_padded_dec<3>(1234)), "1234");
+	_ASSERTEQUAL(tc::make_str<char>(tc::as_padded_dec<25>(std::numeric_limits<std::uint64_t>::max())), "0000018446744073709551615");
+	_ASSERTEQUAL(tc::make_str<char>("x=", tc::as_dec(42), ", y=", tc::as_padded_dec<2>(5)), "x=42, y=05");
+}
+
+UNITTESTDEF(as_dec_floating_point) {
+	_ASSERTEQUAL(tc::make_str<char>(tc::as_dec(0.1)), "0.1");
+	_ASSERTEQUAL(tc::make_str<char>(tc::as_dec(0.1f)), "0.1");
+	_ASSERTEQUAL(tc::make_str<char>(tc::as_dec(100.0)), "100");
+	_ASSERTEQUAL(tc::make_str<char>(tc::as_dec(-0.0)), "-0");
+	_ASSERTEQUAL(tc::make_str<char>(tc::as_dec(1e21)), "1e+21");
+	_ASSERTEQUAL(tc::make_str<char>(tc::as_dec(std::numeric_limits<double>::denorm_min())), "5e-324");
+	_ASSERTEQUAL(tc::make_str<char>(tc::as_dec(-std::numeric_limits<double>::min())), "-2.2250738585072014e-308");
+	_ASSERTEQUAL(tc::make_str<char>(tc::as_dec(std::numeric_limits<double>::infinity())), "inf");
+
+	// round trip through the parser
+	std::uint64_t n = 0x9e3779b97f4a7c15;
+	for( int i = 0; i < 10000; ++i ) {
+		n = n * 6364136223846793005 + 1442695040888963407;
+		auto const f = tc::bit_cast<double>(n);
+		if( std::isfinite(f) ) {
+			auto const str = tc::make_str<char>(tc::as_dec(f));
+			_ASSERT(tc::size(str) <= decltype(tc::as_dec(f))::c_nMaxSize);
+			_ASSERTEQUAL(tc::bit_cast<std::uint64_t>(tc::floating_point_from_string<double>(str)), n);
+		}
+	}
+}
+
+#ifdef __cpp_lib_to_chars
+namespace {
+	template<typename T, typename TBits>
+	void CompareWithCharconv(TBits const n) noexcept {
+		auto const f = tc::bit_cast<T>(n);
+		std::array<char, decltype(tc::as_dec(f))::c_nMaxSize> achExpected;
+		auto const result = std::to_chars(achExpected.data(), achExpected.data() + achExpected.size(), f);
+		_ASSERTEQUAL(result.ec, std::errc());
+		std::array<char, decltype(tc::as_dec(f))::c_nMaxSize> ach;
+		auto const pchEnd = tc::floating_point_as_dec_detail::to_chars(ach.data(), ach.size(), f);
+		_ASSERTEQUAL(std::string(ach.data(), pchEnd), std::string(achExpected.data(), result.ptr));
+
+		auto const pairfpch = tc::floating_point_from_string_detail::strto_chars<T>(achExpected.data(), result.ptr);
+		_ASSERTEQUAL(pairfpch.second, result.ptr);
+		_ASSERT(std::isnan(f) ? std::isnan(pairfpch.first) && std::signbit(f) == std::signbit(pairfpch.first) : tc::bit_cast<TBits>(pairfpch.first) == n);
+	}
+}
+
+UNITTESTDEF(floating_point_charconv_fallback) {
+	std::uint64_t n = 0x9e3779b97f4a7c15;
+	for( int i = 0; i < 10000; ++i ) {
+		n = n * 6364136223846793005 + 1442695040888963407;
+		CompareWithCharconv<double>(n);
+		CompareWithCharconv<float>(static_cast<std::uint32_t>(n >> 32));
+		CompareWithCharconv<double>(n & 0x800fffff00000000); // subnormal
+		CompareWithCharconv<double>((n & 0x80000000ffffffff) | 0x4330000000000000); // integral
+	}
+	for( double const f : {0.0, -0.0, 1e21, 1e22, 123456789e12, 0.001234, std::numeric_limits<double>::infinity(), -std::numeric_limits<double>::quiet_NaN()} ) {
+		CompareWithCharconv<double>(tc::bit_cast<std::uint64_t>(f));
+	}
+
+	auto const CompareParse = [](std::string const& str) noexcept {
+		auto const pchBegin = str.data();
+		auto const pchEnd = str.data() + str.size();
+		double f = 0;
+		auto const result = std::from_chars(pchBegin, pchEnd, f);
+		auto const pairfpch = tc::floating_point_from_string_detail::strto_chars<double>(pchBegin, pchEnd);
+		_ASSERTEQUAL(pairfpch.second, std::errc() == result.ec ? result.ptr : pchBegin);
+		if( std::errc() == result.ec ) {
+			_ASSERT(std::isnan(f) ? std::isnan(pairfpch.first) && std::signbit(f) == std::signbit(pairfpch.first) : tc::bit_cast<std::uint64_t>(pairfpch.first) == tc::bit_cast<std::uint64_t>(f));
+		}
+	};
+	for( char const* const psz : {"1e5", ".5", "5.", ".", "-.e3", "1e", "1e+", "1E-2x", "0x10", "-0", "nan", "-NaN(abc", "nan(x_1)", "nan()", "INFINITY", "infin", "in", "1e-400", "1e400", "2e-320", "1.5e308x", "00012.50e0001",
+		"0e99999999999999999999", "1e-99999999999999999999", "1.00000000000000011102230246251565404236316680908203125",
+		"123456789012345678901234567890123456789012345678901234567890123456789012345678901234567890123456789012345678901234567890123456789e-100"
+	} ) {
+		CompareParse(psz);
+	}
+	// long numbers are parsed without allocating, digits that cannot affect rounding are dropped
+	CompareParse("1.00000000000000011102230246251565404236316680908203125" + std::string(1000, '0') + "1"); // just above halfway
+	CompareParse("1.00000000000000011102230246251565404236316680908203125" + std::string(1000, '0'));
+	CompareParse("0." + std::string(1000, '0') + "123e1000");
+	CompareParse(std::string(1000, '9') + "e-1000");
+	CompareParse("2.4703282292062327208828439643411068618252990130716238221279284125033775363510437593264991818081799618989828234772285265448237602741"
+		"7903553457813542592880869218014437467424012845727302155735587428346152536939097124193405137131233002734765027148862547126097327045"
+		"3727373227062726658862787628584768856125818640131545047001036536024880493627396883424498541298697436818946209924399149706706316012"
+		"3282393233612024768962486127424547017734108106958536452271094935282136426669127219097553011548591413669101908101007497154898618069"
+		"6045625432633493217463018773614101466893612649880616497939498221128553036513834611604542633669659010218040223024436218154808099961"
+		"1212396054148055637591279493099001659000781148497227226669130716106131766005069848716853519898125041627853281839008640312549049012"
+		"6234024549520087101493508366839862102393869826519298659466452283898097839549787620101427924500451017300000000000000000000000000e-324");
+}
+#endif
+
+UNITTESTDEF(floating_point_from_string) {
+	{
+		auto const str = tc::make_str<char>("3.25abc");
+		auto const pairfit = tc::floating_point_from_string_head<double>(str);
+		_ASSERTEQUAL(pairfit.first, 3.25);
+		_ASSERTEQUAL(pairfit.second - tc::begin(str), 4);
+	}
+	_ASSERTEQUAL(tc::floating_point_from_string<double>(tc::make_str<char>("+1.5")), 1.5);
+	_ASSERTEQUAL(tc::floating_point_from_string<float>(tc::make_str<char>("-2e-3")), -2e-3f);
+	{
+		auto const str = tc::make_str<char>("+-1");
+		_ASSERT(tc::begin(str) == tc::floating_point_from_string_head<double>(str).second);
+	}
+	{
+		auto const str = tc::make_str<char>("1e400");
+		_ASSERT(tc::begin(str) == tc::floating_point_from_string_head<double>(str).second); // out of range
+	}
+	{
+		auto const str = tc::make_str<tc::char16>(UTF16("2.5e3x"));
+		auto const pairfit = tc::floating_point_from_string_head<double>(str);
+		_ASSERTEQUAL(pairfit.first, 2500.0);
+		_ASSERTEQUAL(pairfit.second - tc::begin(str), 5);
+	}
+	try {
+		static_cast<void>(tc::floating_point_from_string<double>(tc::make_str<char>("1.5 ")));
+		_ASSERTFALSE;
+	} catch( tc::floating_point_parse_exception const& ) {
+	}
+}
+
+UNITTESTDEF(integer_from_string) {
+	auto const Signed = [](auto const t, char const* const psz) noexcept {
+		auto const str = tc::make_str<char>(tc::as_c_str(psz));
+		auto const pairnit = tc::signed_integer_from_string_head<std::remove_const_t<decltype(t)>>(str);
+		return std::make_pair(pairnit.first, pairnit.second - tc::begin(str));
+	};
+	auto const Unsigned = [](auto const t, char const* const psz) noexcept {
+		auto const str = tc::make_str<char>(tc::as_c_str(psz));
+		auto const pairnit = tc::unsigned_integer_from_string_head<std::remove_const_t<decltype(t)>>(str);
+		return std::make_pair(pairnit.first, pairnit.second - tc::begin(str));
+	};
+	_ASSERT(std::make_pair(std::int64_t(1234567890123456789), std::ptrdiff_t(19)) == Signed(std::int64_t(), "1234567890123456789x"));
+	_ASSERT(std::make_pair(std::numeric_limits<std::int64_t>::lowest(), std::ptrdiff_t(20)) == Signed(std::int64_t(), "-9223372036854775808"));
+	_ASSERT(std::make_pair(std::int64_t(-922337203685477580), std::ptrdiff_t(19)) == Signed(std::int64_t(), "-9223372036854775809")); // stops before underflow
+	_ASSERT(std::make_pair(std::numeric_limits<std::uint64_t>::max(), std::ptrdiff_t(20)) == Unsigned(std::uint64_t(), "18446744073709551615"));
+	_ASSERT(std::make_pair(std::uint64_t(1844674407370955161), std::ptrdiff_t(19)) == Unsigned(std::uint64_t(), "18446744073709551616")); // stops before overflow
+	_ASSERT(std::make_pair(std::uint64_t(12345678), std::ptrdiff_t(8)) == Unsigned(std::uint64_t(), "12345678:9"));
+	_ASSERT(std::make_pair(std::int32_t(2147483647), std::ptrdiff_t(11)) == Signed(std::int32_t(), "+2147483647"));
+	_ASSERT(std::make_pair(std::int32_t(214748364), std::ptrdiff_t(9)) == Signed(std::int32_t(), "2147483648"));
+	_ASSERT(std::make_pair(std::int8_t(-128), std::ptrdiff_t(4)) == Signed(std::int8_t(), "-128"));
+	_ASSERT(std::make_pair(std::uint16_t(6553), std::ptrdiff_t(4)) == Unsigned(std::uint16_t(), "65536"));
+	_ASSERT(std::make_pair(0, std::ptrdiff_t(1)) == Signed(0, "+-1"));
+
+	// the fast path for contiguous char ranges agrees with the generic one
+	for( std::uint64_t n = 1; n < std::numeric_limits<std::uint64_t>::max() / 7; n = n * 7 + 3 ) {
+		auto const str = tc::make_str<char>(tc::as_dec(n), "/", tc::as_dec(-tc::explicit_cast<std::int64_t>(n / 2)));
+		auto const str16 = tc::make_str<tc::char16>(str);
+		_ASSERTEQUAL(tc::unsigned_integer_from_string_head<std::uint64_t>(str).first, n);
+		_ASSERTEQUAL(tc::unsigned_integer_from_string_head<std::uint64_t>(str16).first, n);
+		_ASSERTEQUAL(tc::unsigned_integer_from_string_head<std::uint32_t>(str).first, tc::unsigned_integer_from_string_head<std::uint32_t>(str16).first);
+		_ASSERTEQUAL(tc::unsigned_integer_from_string_head<std::uint32_t>(str).second - tc::begin(str), tc::unsigned_integer_from_string_head<std::uint32_t>(str16).second - tc::begin(str16));
+		auto const strNegative = tc::begin_next<tc::return_drop>(str, tc::find_first<tc::return_element_index>(str, '/') + 1);
+		_ASSERTEQUAL(tc::signed_integer_from_string_head<std::int64_t>(strNegative).first, -tc::explicit_cast<std::int64_t>(n / 2));
+	}
+}
+
+UNITTESTDEF(integers_from_delimited_string) {
+	TEST_RANGE_EQUAL(tc::integers_from_delimited_string<int>(tc::make_str<char>("1,-22,333,4444444,+5"), ','), tc::make_array(tc::aggregate_tag, 1, -22, 333, 4444444, 5));
+	TEST_RANGE_EQUAL(tc::integers_from_delimited_string<unsigned int>(tc::make_str<tc::char16>(UTF16("7;8")), UTF16(';')), tc::make_array(tc::aggregate_tag, 7u, 8u));
+	_ASSERT(tc::empty(tc::integers_from_delimited_string<int>(tc::make_str<char>(""), ',')));
+	for( char const* const psz : {"1,,2", "1,2,", "1;2", "99999999999"} ) {
+		try {
+			static_cast<void>(tc::integers_from_delimited_string<int>(tc::make_str<char>(tc::as_c_str(psz)), ','));
+			_ASSERTFALSE;
+		} catch( tc::integer_parse_exception const& ) {
+		}
+	}
+}
+
+UNITTESTDEF(format) {
+	_ASSERTEQUAL(tc::make_str<char>(tc::format<"({}, {})">(tc::as_dec(-1), tc::as_dec(2.5))), "(-1, 2.5)");
+	_ASSERTEQUAL(tc::make_str<char>(tc::format<"{}{}">("ab", tc::as_hex<2>(0xfu))), "ab0F");
+	_ASSERTEQUAL(tc::make_str<char>(tc::format<"{{{}}} }}{{">(tc::as_dec(42))), "{42} }{");
+	_ASSERTEQUAL(tc::make_str<char>(tc::format<"no placeholders">()), "no placeholders");
+	_ASSERT(tc::equal(tc::make_str<tc::char16>(tc::format<UTF16("x={}")>(tc::as_dec(3))), UTF16("x=3")));
+
+	auto const str = tc::make_str<char>("a longer string that does not fit into the small string buffer");
+	auto const rng = tc::format<"{}: {} [{}]">(str, tc::as_dec(std::numeric_limits<std::int64_t>::lowest()), tc::as_unpadded_hex(255u));
+	_ASSERTEQUAL(tc::size_upper_bound(rng), tc::size(str) + 2 + 20 + 2 + 8 + 1);
+	tc::vector<char> vech;
+	tc::append(vech, rng);
+	_ASSERT(tc::equal(vech, tc::concat(str, ": -9223372036854775808 [FF]")));
+	_ASSERTEQUAL(vech.capacity(), tc::size_upper_bound(rng)); // reserved once
+
+	// arguments without a size bound are formatted, but memory is not reserved up front
+	auto const rngUnbounded = tc::format<"{}!">(tc::filter(str, [](char const ch) noexcept { return ' ' != ch; }));
+	static_assert( !tc::has_size_upper_bound<decltype(rngUnbounded)> );
+	_ASSERT(tc::equal(tc::make_str<char>(rngUnbounded), "alongerstringthatdoesnotfitintothesmallstringbuffer!"));
+}
@@ -0,0 +1,211 @@
+// think-cell public library
+//
+// Copyright (C) 2016-2023 think-cell Software GmbH
+//
+// Distributed under the Boost Software License, Version 1.0.
+// See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt
+
+#pragma once
+
+#include "../base/assert_defs.h"
+#include "../base/fundamental.h"
+#include "../algorithm/simd.h"
+
+#include <cstddef>
+#include <cstdint>
+
+// Bulk UTF-8 <-> UTF-16 transcoding of contiguous memory. Runs of ASCII are converted 16 or 32 code units at a time,
+// other code points one at a time. The kernels stop in front of the first sequence that is not a valid encoding.
+namespace tc {
+	namespace transcode_utf_detail {
+		template<typename Src, typename Dst>
+		struct result final {
+			Src const* m_pSrc;
+			Dst* m_pDst;
+		};
+
+		// Upper bound of the destination size for nSrc source code units, including U+FFFD for invalid sequences.
+		template<typename Dst>
+		constexpr std::size_t max_dst_size(std::size_t const nSrc) noexcept {
+			if constexpr( std::is_same<Dst, tc::char16>::value ) {
+				return nSrc; // 1-3 UTF-8 code units to one UTF-16 code unit, 4 to a surrogate pair
+			} else {
+				static_assert( std::is_same<Dst, char>::value );
+				return 3 * nSrc; // one UTF-16 code unit to at most 3 UTF-8 code units, a surrogate pair to 4
+			}
+		}
+
+#ifdef TC_SIMD_X64
+		// Return the number of converted code units, which is a multiple of the vector width.
+		inline std::size_t widen_ascii_128(char const* const p, std::size_t const n, tc::char16* const pDst) noexcept {
+			std::size_t i = 0;
+			for( ; i + 16 <= n; i += 16 ) {
+				__m128i const v = _mm_loadu_si128(reinterpret_cast<__m128i const*>(p + i));
+				if( 0 != _mm_movemask_epi8(v) ) break;
+				_mm_storeu_si128(reinterpret_cast<__m128i*>(pDst + i), _mm_unpacklo_epi8(v, _mm_setzero_si128()));
+				_mm_storeu_si128(reinterpret_cast<__m128i*>(pDst + i + 8), _mm_unpackhi_epi8(v, _mm_setzero_si128()));
+			}
+			return i;
+		}
+
+		TC_TARGET_AVX2 inline std::size_t widen_ascii_256(char const* const p, std::size_t const n, tc::char16* const pDst) noexcept {
+			std::size_t i = 0;
+			for( ; i + 32 <= n; i += 32 ) {
+				__m256i const v = _mm256_loadu_si256(reinterpret_cast<__m256i const*>(p + i));
+				if( 0 != _mm256_movemask_epi8(v) ) break;
+				_mm256_storeu_si256(reinterpret_cast<__m256i*>(pDst + i), _mm256_cvtepu8_epi16(_mm256_castsi256_si128(v)));
+				_mm256_storeu_si256(reinterpret_cast<__m256i*>(pDst + i + 16), _mm256_cvtepu8_epi16(_mm256_extracti128_si256(v, 1)));
+			}
+			return i;
+		}
+
+		inline std::size_t narrow_ascii_128(tc::char16 const* const p, std::size_t const n, char* const pDst) noexcept {
+			__m128i const vNonAscii = _mm_set1_epi16(static_cast<short>(0xff80));
+			std::size_t i = 0;
+			for( ; i + 16 <= n; i += 16 ) {
+				__m128i const vLo = _mm_loadu_si128(reinterpret_cast<__m128i const*>(p + i));
+				__m128i const vHi = _mm_loadu_si128(reinterpret_cast<__m128i const*>(p + i + 8));
+				if( 0xffff != _mm_movemask_epi8(_mm_cmpeq_epi16(_mm_and_si128(_mm_or_si128(vLo, vHi), vNonAscii), _mm_setzero_si128())) ) break;
+				_mm_storeu_si128(reinterpret_cast<__m128i*>(pDst + i), _mm_packus_epi16(vLo, vHi));
+			}
+			return i;
+		}
+
+		TC_TARGET_AVX2 inline std::size_t narrow_ascii_256(tc::char16 const* const p, std::size_t const n, char* const pDst) noexcept {
+			__m256i const vNonAscii = _mm256_set1_epi16(static_cast<short>(0xff80));
+			std::size_t i = 0;
+			for( ; i + 32 <= n; i += 32 ) {
+				__m256i const vLo = _mm256_loadu_si256(reinterpret_cast<__m256i const*>(p + i));
+				__m256i const vHi = _mm256_loadu_si256(reinterpret_cast<__m256i const*>(p + i + 16));
+				if( !_mm256_testz_si256(_mm256_or_si256(vLo, vHi), vNonAscii) ) break;
+				// packus works within 128-bit lanes, restore the order of the 64-bit quarters
+				_mm256_storeu_si256(reinterpret_cast<__m256i*>(pDst + i), _mm256_permute4x64_epi64(_mm256_packus_epi16(vLo, vHi), 0xd8));
+			}
+			return i;
+		}
+#endif
+
+		inline std::size_t convert_ascii(char const* const p, std::size_t const n, tc::char16* const pDst) noexcept {
+#ifdef TC_SIMD_X64
+			return tc::simd_detail::has_avx2() ? widen_ascii_256(p, n, pDst) : widen_ascii_128(p, n, pDst);
+#else
+			return 0;
+#endif
+		}
+
+		inline std::size_t convert_ascii(tc::char16 const* const p, std::size_t const n, char* const pDst) noexcept {
+#ifdef TC_SIMD_X64
+			return tc::simd_detail::has_avx2() ? narrow_ascii_256(p, n, pDst) : narrow_ascii_128(p, n, pDst);
+#else
+			return 0;
+#endif
+		}
+
+		inline unsigned int codeunit(char const ch) noexcept {
+			return static_cast<unsigned char>(ch);
+		}
+
+		inline unsigned int codeunit(tc::char16 const ch) noexcept {
+			return static_cast<std::uint16_t>(ch);
+		}
+
+		// Decodes the code point at p, if it is validly encoded. Sequences may extend up to pEnd.
+		inline int decode(char const* const p, char const* const pEnd, char32_t& ch) noexcept {
+			auto const n0 = codeunit(*p);
+			auto const Trailing = [&](int const i) noexcept {
+				return i < pEnd - p && 0x80 == (codeunit(p[i]) & 0xc0);
+			};
+			if( n0 < 0xc2 ) {
+				return 0; // continuation code unit or overlong 2-byte sequence (ASCII is handled by the caller)
+			} else if( n0 < 0xe0 ) {
+				if( !Trailing(1) ) return 0;
+				ch = static_cast<char32_t>((n0 & 0x1f) << 6 | (codeunit(p[1]) & 0x3f));
+				return 2;
+			} else if( n0 < 0xf0 ) {
+				if( !Trailing(1) || !Trailing(2) ) return 0;
+				auto const n = (n0 & 0x0f) << 12 | (codeunit(p[1]) & 0x3f) << 6 | (codeunit(p[2]) & 0x3f);
+				if( n < 0x800 || (0xd800 <= n && n <= 0xdfff) ) return 0; // overlong or surrogate
+				ch = static_cast<char32_t>(n);
+				return 3;
+			} else if( n0 < 0xf5 ) {
+				if( !Trailing(1) || !Trailing(2) || !Trailing(3) ) return 0;
+				auto const n = (n0 & 0x07) << 18 | (codeunit(p[1]) & 0x3f) << 12 | (codeunit(p[2]) & 0x3f) << 6 | (codeunit(p[3]) & 0x3f);
+				if( n < 0x10000 || 0x110000 <= n ) return 0; // overlong or beyond U+10FFFF
+				ch = static_cast<char32_t>(n);
+				return 4;
+			} else {
+				return 0;
+			}
+		}
+
+		inline int decode(tc::char16 const* const p, tc::char16 const* const pEnd, char32_t& ch) noexcept {
+			auto const n0 = codeunit(*p);
+			if( n0 < 0xd800 || 0xdfff < n0 ) {
+				ch = static_cast<char32_t>(n0);
+				return 1;
+			} else if( n0 < 0xdc00 && 1 < pEnd - p ) {
+				if( auto const n1 = codeunit(p[1]); 0xdc00 <= n1 && n1 <= 0xdfff ) {
+					ch = static_cast<char32_t>(((n0 - 0xd800) << 10) + (n1 - 0xdc00) + 0x10000);
+					return 2;
+				}
+			}
+			return 0; // unpaired surrogate
+		}
+
+		inline tc::char16* encode(char32_t const ch, tc::char16* pDst) noexcept {
+			auto const n = static_cast<unsigned int>(ch);
+			if( n < 0x10000 ) {
+				*pDst++ = static_cast<tc::char16>(n);
+			} else {
+				*pDst++ = static_cast<tc::char16>(((n - 0x10000) >> 10) + 0xd800);
+				*pDst++ = static_cast<tc::char16>(((n - 0x10000) & 0x3ff) + 0xdc00);
+			}
+			return pDst;
+		}
+
+		inline char* encode(char32_t const ch, char* pDst) noexcept {
+			auto const n = static_cast<unsigned int>(ch);
+			if( n < 0x80 ) {
+				*pDst++ = static_cast<char>(n);
+			} else if( n < 0x800 ) {
+				*pDst++ = static_cast<char>(0xc0 | n >> 6);
+				*pDst++ = static_cast<char>(0x80 | (n & 0x3f));
+			} else if( n < 0x10000 ) {
+				*pDst++ = static_cast<char>(0xe0 | n >> 12);
+				*pDst++ = static_cast<char>(0x80 | (n >> 6 & 0x3f));
+				*pDst++ = static_cast<char>(0x80 | (n & 0x3f));
+			} else {
+				*pDst++ = static_cast<char>(0xf0 | n >> 18);
+				*pDst++ = static_cast<char>(0x80 | (n >> 12 & 0x3f));
+				*pDst++ = static_cast<char>(0x80 | (n >> 6 & 0x3f));
+				*pDst++ = static_cast<char>(0x80 | (n & 0x3f));
+			}
+			return pDst;
+		}
+
+		// Transcodes the code points starting in [p, pLimit), whose sequences may extend up to pEnd.
+		// Stops in front of the first invalid sequence. pDst must have room for max_dst_size<Dst>(pLimit-p) code units,
+		// plus one if pLimit < pEnd, because the last code point may extend beyond pLimit.
+		template<typename Src, typename Dst>
+		result<Src, Dst> transcode_valid(Src const* p, Src const* const pLimit, Src const* const pEnd, Dst* pDst) noexcept {
+			_ASSERTDEBUG(p <= pLimit && pLimit <= pEnd);
+			while( p < pLimit ) {
+				if( codeunit(*p) < 0x80 ) {
+					auto const n = transcode_utf_detail::convert_ascii(p, tc::explicit_cast<std::size_t>(pLimit - p), pDst);
+					p += n;
+					pDst += n;
+					for( ; p < pLimit && codeunit(*p) < 0x80; ++p, ++pDst ) {
+						*pDst = static_cast<Dst>(codeunit(*p));
+					}
+				} else {
+					char32_t ch;
+					auto const nSrc = transcode_utf_detail::decode(p, pEnd, ch);
+					if( 0 == nSrc ) break;
+					p += nSrc;
+					pDst = transcode_utf_detail::encode(ch, pDst);
+				}
+			}
+			return {p, pDst};
+		}
+	}
+}
@@ -0,0 +1,252 @@
+// think-cell public library
+//
+// Copyright (C) 2016-2023 think-cell Software GmbH
+//
+// Distributed under the Boost Software License, Version 1.0.
+// See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt
+
+#pragma once
+
+#include "../base/assert_defs.h"
+#include "../algorithm/find.h"
+#include "../algorithm/simd.h"
+#include "transcode_utf.h"
+
+#include <memory>
+
+namespace tc {
+	namespace validate_utf_detail {
+		// Returns the start of the ASCII code units following p, rounded down to a multiple of the vector width.
+		inline char const* skip_ascii(char const* p, char const* const pEnd) noexcept {
+#ifdef TC_SIMD_X64
+			for( ; 16 <= pEnd - p && 0 == _mm_movemask_epi8(_mm_loadu_si128(reinterpret_cast<__m128i const*>(p))); p += 16 ) {}
+#endif
+			return p;
+		}
+
+		inline char const* first_invalid_scalar(char const* p, char const* const pEnd) noexcept {
+			while( p < pEnd ) {
+				p = validate_utf_detail::skip_ascii(p, pEnd);
+				for( ; p < pEnd && transcode_utf_detail::codeunit(*p) < 0x80; ++p ) {}
+				if( p == pEnd ) break;
+				char32_t ch;
+				auto const nSrc = transcode_utf_detail::decode(p, pEnd, ch);
+				if( 0 == nSrc ) return p;
+				p += nSrc;
+			}
+			return nullptr;
+		}
+
+#ifdef TC_SIMD_X64
+		// Range of code unit pairs (prev1, ch) that cannot occur in valid UTF-8 as bit flags, looked up by the high and low nibble
+		// of prev1 and the high nibble of ch. Continuation code units following 3- and 4-byte leads are checked separately.
+		// The lookup tables follow Keiser and Lemire, "Validating UTF-8 In Less Than One Instruction Per Byte" (2021).
+		inline constexpr char c_chTooShort = 1 << 0; // 11______ 0_______, 11______ 11______
+		inline constexpr char c_chTooLong = 1 << 1; // 0_______ 10______
+		inline constexpr char c_chOverlong3 = 1 << 2; // 11100000 100_____
+		inline constexpr char c_chTooLarge = 1 << 3; // 11110100 1001____, 11110100 101_____, 11110101+ 1001____, 11110101+ 101_____
+		inline constexpr char c_chSurrogate = 1 << 4; // 11101101 101_____
+		inline constexpr char c_chOverlong2 = 1 << 5; // 1100000_ 10______
+		inline constexpr char c_chTooLarge1000 = 1 << 6; // 11110101+ 1000____
+		inline constexpr char c_chOverlong4 = 1 << 6; // 11110000 1000____
+		inline constexpr char c_chTwoConts = static_cast<char>(1 << 7); // 10______ 10______
+		inline constexpr char c_chCarry = c_chTooShort | c_chTooLong | c_chTwoConts;
+
+		TC_TARGET_AVX2 inline __m256i lookup_nibble(__m256i const v, __m256i const vTable) noexcept {
+			return _mm256_shuffle_epi8(vTable, v);
+		}
+
+		// Returns the start of the first block of 32 code units in which an error is detected, or the start of the remainder
+		// shorter than a block. All code points ending before the returned position are valid.
+		TC_TARGET_AVX2 inline char const* skip_valid_256(char const* p, char const* const pEnd) noexcept {
+			__m256i const vByte1High = _mm256_setr_epi8(
+				c_chTooLong, c_chTooLong, c_chTooLong, c_chTooLong, c_chTooLong, c_chTooLong, c_chTooLong, c_chTooLong,
+				c_chTwoConts, c_chTwoConts, c_chTwoConts, c_chTwoConts,
+				c_chTooShort | c_chOverlong2,
+				c_chTooShort,
+				c_chTooShort | c_chOverlong3 | c_chSurrogate,
+				c_chTooShort | c_chTooLarge | c_chTooLarge1000 | c_chOverlong4,
+				c_chTooLong, c_chTooLong, c_chTooLong, c_chTooLong, c_chTooLong, c_chTooLong, c_chTooLong, c_chTooLong,
+				c_chTwoConts, c_chTwoConts, c_chTwoConts, c_chTwoConts,
+				c_chTooShort | c_chOverlong2,
+				c_chTooShort,
+				c_chTooShort | c_chOverlong3 | c_chSurrogate,
+				c_chTooShort | c_chTooLarge | c_chTooLarge1000 | c_chOverlong4
+			);
+			__m256i const vByte1Low = _mm256_setr_epi8(
+				c_chCarry | c_chOverlong3 | c_chOverlong2 | c_chOverlong4,
+				c_chCarry | c_chOverlong2,
+				c_chCarry,
+				c_chCarry,
+				c_chCarry | c_chTooLarge,
+				c_chCarry | c_chTooLarge | c_chTooLarge1000, c_chCarry | c_chTooLarge | c_chTooLarge1000, c_chCarry | c_chTooLarge | c_chTooLarge1000, c_chCarry | c_chTooLarge | c_chTooLarge1000,
+				c_chCarry | c_chTooLarge | c_chTooLarge1000, c_chCarry | c_chTooLarge | c_chTooLarge1000, c_chCarry | c_chTooLarge | c_chTooLarge1000, c_chCarry | c_chTooLarge | c_chTooLarge1000,
+				c_chCarry | c_chTooLarge | c_chTooLarge1000 | c_chSurrogate,
+				c_chCarry | c_chTooLarge | c_chTooLarge1000,
+				c_chCarry | c_chTooLarge | c_chTooLarge1000,
+				c_chCarry | c_chOverlong3 | c_chOverlong2 | c_chOverlong4,
+				c_chCarry | c_chOverlong2,
+				c_chCarry,
+				c_chCarry,
+				c_chCarry | c_chTooLarge,
+				c_chCarry | c_chTooLarge | c_chTooLarge1000, c_chCarry | c_chTooLarge | c_chTooLarge1000, c_chCarry | c_chTooLarge | c_chTooLarge1000, c_chCarry | c_chTooLarge | c_chTooLarge1000,
+				c_chCarry | c_chTooLarge | c_chTooLarge1000, c_chCarry | c_chTooLarge | c_chTooLarge1000, c_chCarry | c_chTooLarge | c_chTooLarge1000, c_chCarry | c_chTooLarge | c_chTooLarge1000,
+				c_chCarry | c_chTooLarge | c_chTooLarge1000 | c_chSurrogate,
+				c_chCarry | c_chTooLarge | c_chTooLarge1000,
+				c_chCarry | c_chTooLarge | c_chTooLarge1000
+			);
+			__m256i const vByte2High = _mm256_setr_epi8(
+				c_chTooShort, c_chTooShort, c_chTooShort, c_chTooShort, c_chTooShort, c_chTooShort, c_chTooShort, c_chTooShort,
+				c_chTooLong | c_chOverlong2 | c_chTwoConts | c_chOverlong3 | c_chTooLarge1000 | c_chOverlong4,
+				c_chTooLong | c_chOverlong2 | c_chTwoConts | c_chOverlong3 | c_chTooLarge,
+				c_chTooLong | c_chOverlong2 | c_chTwoConts | c_chSurrogate | c_chTooLarge,
+				c_chTooLong | c_chOverlong2 | c_chTwoConts | c_chSurrogate | c_chTooLarge,
+				c_chTooShort, c_chTooShort, c_chTooShort, c_chTooShort,
+				c_chTooShort, c_chTooShort, c_chTooShort, c_chTooShort, c_chTooShort, c_chTooShort, c_chTooShort, c_chTooShort,
+				c_chTooLong | c_chOverlong2 | c_chTwoConts | c_chOverlong3 | c_chTooLarge1000 | c_chOverlong4,
+				c_chTooLong | c_chOverlong2 | c_chTwoConts | c_chOverlong3 | c_chTooLarge,
+				c_chTooLong | c_chOverlong2 | c_chTwoConts | c_chSurrogate | c_chTooLarge,
+				c_chTooLong | c_chOverlong2 | c_chTwoConts | c_chSurrogate | c_chTooLarge,
+				c_chTooShort, c_chTooShort, c_chTooShort, c_chTooShort
+			);
+			__m256i const vNibble = _mm256_set1_epi8(0x0f);
+
+			__m256i vPrev = _mm256_setzero_si256();
+			for( ; 32 <= pEnd - p; p += 32 ) {
+				__m256i const v = _mm256_loadu_si256(reinterpret_cast<__m256i const*>(p));
+				if( 0 == _mm256_movemask_epi8(_mm256_or_si256(v, vPrev)) ) {
+					vPrev = v; // ASCII following complete sequences
+					continue;
+				}
+				// the last 16 code units of vPrev followed by the first 16 of v, shifted into each lane
+				__m256i const vPrevLane = _mm256_permute2x128_si256(vPrev, v, 0x21);
+				__m256i const vPrev1 = _mm256_alignr_epi8(v, vPrevLane, 15);
+				__m256i const vPrev2 = _mm256_alignr_epi8(v, vPrevLane, 14);
+				__m256i const vPrev3 = _mm256_alignr_epi8(v, vPrevLane, 13);
+
+				__m256i const vSpecial = _mm256_and_si256(
+					_mm256_and_si256(
+						lookup_nibble(_mm256_and_si256(_mm256_srli_epi16(vPrev1, 4), vNibble), vByte1High),
+						lookup_nibble(_mm256_and_si256(vPrev1, vNibble), vByte1Low)
+					),
+					lookup_nibble(_mm256_and_si256(_mm256_srli_epi16(v, 4), vNibble), vByte2High)
+				);
+				// the second and third continuation code units of 3- and 4-byte sequences must be exactly where the leads require
+				__m256i const vMust23 = _mm256_and_si256(
+					_mm256_or_si256(_mm256_subs_epu8(vPrev2, _mm256_set1_epi8(static_cast<char>(0xe0 - 0x80))), _mm256_subs_epu8(vPrev3, _mm256_set1_epi8(static_cast<char>(0xf0 - 0x80)))),
+					_mm256_set1_epi8(static_cast<char>(0x80))
+				);
+				if( !_mm256_testz_si256(_mm256_xor_si256(vMust23, vSpecial), _mm256_xor_si256(vMust23, vSpecial)) ) break;
+				vPrev = v;
+			}
+			return p;
+		}
+#endif
+
+		// Moves p back to the start of the code point that contains p[-1], which is a code point boundary in valid UTF-8.
+		inline char const* codepoint_begin(char const* const pBegin, char const* p) noexcept {
+			for( int i = 0; i < 3 && pBegin < p && 0x80 == (transcode_utf_detail::codeunit(p[-1]) & 0xc0); ++i ) --p;
+			if( pBegin < p && 0xc0 <= transcode_utf_detail::codeunit(p[-1]) ) --p;
+			return p;
+		}
+
+		inline char const* first_invalid(char const* const pBegin, char const* const pEnd) noexcept {
+			auto p = pBegin;
+#ifdef TC_SIMD_X64
+			if( tc::simd_detail::has_avx2() ) {
+				p = validate_utf_detail::codepoint_begin(pBegin, validate_utf_detail::skip_valid_256(pBegin, pEnd));
+			}
+#endif
+			return validate_utf_detail::first_invalid_scalar(p, pEnd);
+		}
+
+#ifdef TC_SIMD_X64
+		// Return the number of code units that are no surrogates, rounded down to a multiple of the vector width.
+		inline std::size_t count_non_surrogates_128(tc::char16 const* const p, std::size_t const n) noexcept {
+			__m128i const vMask = _mm_set1_epi16(static_cast<short>(0xf800));
+			__m128i const vSurrogate = _mm_set1_epi16(static_cast<short>(0xd800));
+			std::size_t i = 0;
+			for( ; i + 8 <= n && 0 == _mm_movemask_epi8(_mm_cmpeq_epi16(_mm_and_si128(_mm_loadu_si128(reinterpret_cast<__m128i const*>(p + i)), vMask), vSurrogate)); i += 8 ) {}
+			return i;
+		}
+
+		TC_TARGET_AVX2 inline std::size_t count_non_surrogates_256(tc::char16 const* const p, std::size_t const n) noexcept {
+			__m256i const vMask = _mm256_set1_epi16(static_cast<short>(0xf800));
+			__m256i const vSurrogate = _mm256_set1_epi16(static_cast<short>(0xd800));
+			std::size_t i = 0;
+			for( ; i + 16 <= n && 0 == _mm256_movemask_epi8(_mm256_cmpeq_epi16(_mm256_and_si256(_mm256_loadu_si256(reinterpret_cast<__m256i const*>(p + i)), vMask), vSurrogate)); i += 16 ) {}
+			return i;
+		}
+#endif
+
+		inline tc::char16 const* first_invalid(tc::char16 const* p, tc::char16 const* const pEnd) noexcept {
+			while( p < pEnd ) {
+#ifdef TC_SIMD_X64
+				auto const n = tc::explicit_cast<std::size_t>(pEnd - p);
+				p += tc::simd_detail::has_avx2() ? count_non_surrogates_256(p, n) : count_non_surrogates_128(p, n);
+#endif
+				// Check the block containing a surrogate code unit one code point at a time.
+				for( auto const pStop = pEnd - p < 16 ? pEnd : p + 16; p < pStop; ) {
+					char32_t ch;
+					auto const nSrc = transcode_utf_detail::decode(p, pEnd, ch);
+					if( 0 == nSrc ) return p;
+					p += nSrc;
+				}
+			}
+			return nullptr;
+		}
+
+		// Like tc::find_first, ranges whose end is a sentinel, e.g., zero-terminated strings, are not vectorized,
+		// but checked one code point at a time.
+		template<typename Char, typename It, typename End>
+		Char const* first_invalid_sentinel(It it, End const& itEnd) noexcept {
+			while( it != itEnd ) {
+				if constexpr( std::same_as<Char, char> ) {
+					if( transcode_utf_detail::codeunit(*it) < 0x80 ) {
+						++it;
+						continue;
+					}
+				}
+				Char achCodeUnit[4];
+				int nCodeUnit = 0;
+				for( auto itCodeUnit = it; nCodeUnit < 4 && itCodeUnit != itEnd; ++itCodeUnit ) {
+					achCodeUnit[nCodeUnit++] = *itCodeUnit;
+				}
+				char32_t ch;
+				auto const nSrc = transcode_utf_detail::decode(achCodeUnit, achCodeUnit + nCodeUnit, ch);
+				if( 0 == nSrc ) return std::to_address(it);
+				it += nSrc;
+			}
+			return nullptr;
+		}
+	}
+
+	// Finds the start of the first code unit sequence that is not a valid UTF-8 or UTF-16 encoding of a code point.
+	// In contrast to ecodeunitseqtypVALID, overlong encodings, encoded surrogates, code points beyond U+10FFFF and unpaired
+	// surrogates are invalid. Runs of ASCII or of UTF-16 code units without surrogates are checked a vector at a time.
+	template<typename RangeReturn, tc::contiguous_range Rng> requires
+		std::same_as<tc::range_value_t<Rng>, char> || std::same_as<tc::range_value_t<Rng>, tc::char16>
+	[[nodiscard]] decltype(auto) find_first_invalid_utf(Rng&& rng) noexcept {
+		if constexpr( tc::common_range<Rng> ) {
+			return find_simd_detail::pack<RangeReturn>(
+				std::forward<Rng>(rng),
+				validate_utf_detail::first_invalid(std::to_address(tc::begin(rng)), std::to_address(tc::end(rng)))
+			);
+		} else {
+			return find_simd_detail::pack<RangeReturn>(
+				std::forward<Rng>(rng),
+				validate_utf_detail::first_invalid_sentinel<tc::range_value_t<Rng>>(tc::begin(rng), tc::end(rng))
+			);
+		}
+	}
+
+	template<tc::contiguous_range Rng> requires std::same_as<tc::range_value_t<Rng>, char>
+	[[nodiscard]] bool is_valid_utf8(Rng const& rng) noexcept {
+		return !tc::find_first_invalid_utf<tc::return_bool>(rng);
+	}
+
+	template<tc::contiguous_range Rng> requires std::same_as<tc::range_value_t<Rng>, tc::char16>
+	[[nodiscard]] bool is_valid_utf16(Rng const& rng) noexcept {
+		return !tc::find_first_invalid_utf<tc::return_bool>(rng);
+	}
+}
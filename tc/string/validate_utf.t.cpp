@@ -0,0 +1,90 @@
+// think-cell public library
+//
+// Copyright (C) 2016-2023 think-cell Software GmbH
+//
+// Distributed under the Boost Software License, Version 1.0.
+// See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt
+
+#include "../base/assert_defs.h"
+#include "../unittest.h"
+#include "../algorithm/append.h"
+#include "validate_utf.h"
+
+namespace {
+	// Embed psz at every offset of a string long enough for the vectorized path and check that it is found there.
+	void TestInvalidUtf8(char const* const psz) noexcept {
+		for( int nOffset = 0; nOffset < 70; ++nOffset ) {
+			tc::string<char> str;
+			for( int i = 0; i < nOffset; ++i ) {
+				tc::cont_emplace_back(str, 0 == i % 5 ? 'x' : 'a');
+			}
+			tc::append(str, tc::as_c_str(psz), "\xc3\xa4 valid UTF-8 \xe2\x82\xac\xf0\x9f\x98\x80 following the error");
+			_ASSERT(!tc::is_valid_utf8(str));
+			_ASSERTEQUAL(tc::find_first_invalid_utf<tc::return_element_index>(str), nOffset);
+			_ASSERT(tc::is_valid_utf8(tc::find_first_invalid_utf<tc::return_take_before_or_all>(str)));
+		}
+	}
+}
+
+UNITTESTDEF(is_valid_utf8) {
+	_ASSERT(tc::is_valid_utf8(tc::string<char>()));
+	tc::string<char> str;
+	for( int i = 0; i < 100; ++i ) {
+		tc::append(str, "abc", "\xc2\x80", "\xdf\xbf", "\xe0\xa0\x80", "\xed\x9f\xbf", "\xee\x80\x80", "\xef\xbf\xbf", "\xf0\x90\x80\x80", "\xf4\x8f\xbf\xbf");
+		_ASSERT(tc::is_valid_utf8(str));
+		_ASSERT(!tc::find_first_invalid_utf<tc::return_element_or_null>(str));
+	}
+
+	TestInvalidUtf8("\x80"); // lone continuation code unit
+	TestInvalidUtf8("\xc3"); // truncated
+	TestInvalidUtf8("\xe2\x82");
+	TestInvalidUtf8("\xf0\x9f\x98");
+	TestInvalidUtf8("\xc0\xaf"); // overlong
+	TestInvalidUtf8("\xc1\xbf");
+	TestInvalidUtf8("\xe0\x9f\xbf");
+	TestInvalidUtf8("\xf0\x8f\xbf\xbf");
+	TestInvalidUtf8("\xed\xa0\x80"); // surrogates
+	TestInvalidUtf8("\xed\xbf\xbf");
+	TestInvalidUtf8("\xf4\x90\x80\x80"); // beyond U+10FFFF
+	TestInvalidUtf8("\xf5\x80\x80\x80");
+	TestInvalidUtf8("\xff");
+}
+
+UNITTESTDEF(is_valid_utf16) {
+	tc::string<tc::char16> str;
+	for( int i = 0; i < 50; ++i ) {
+		tc::append(str, UTF16("abcdefghijklmnopqrstuvwxyz"));
+		tc::cont_emplace_back(str, tc::char16(0xd83d));
+		tc::cont_emplace_back(str, tc::char16(0xde00));
+		tc::cont_emplace_back(str, tc::char16(0xffff));
+	}
+	_ASSERT(tc::is_valid_utf16(str));
+
+	auto const strValid = str;
+	for( int nOffset = 0; nOffset < 70; ++nOffset ) {
+		// the surrogate pair is at offsets 26 and 27 modulo 29
+		str = strValid;
+		tc::at(str, nOffset) = tc::char16(0xdc00);
+		if( 27 == nOffset % 29 ) {
+			_ASSERT(tc::is_valid_utf16(str));
+		} else {
+			_ASSERTEQUAL(tc::find_first_invalid_utf<tc::return_element_index>(str), nOffset);
+		}
+
+		str = strValid;
+		tc::at(str, nOffset) = tc::char16(0xd800);
+		if( 26 == nOffset % 29 ) {
+			_ASSERT(tc::is_valid_utf16(str));
+		} else {
+			_ASSERTEQUAL(tc::find_first_invalid_utf<tc::return_element_index>(str), 27 == nOffset % 29 ? nOffset - 1 : nOffset);
+		}
+	}
+}
+
+UNITTESTDEF(is_valid_utf8_zero_terminated) {
+	_ASSERT(tc::is_valid_utf8(tc::as_c_str("\xc3\xa4")));
+	_ASSERTEQUAL(tc::find_first_invalid_utf<tc::return_element_index>(tc::as_c_str("ab\xc3")), 2);
+	_ASSERTEQUAL(tc::find_first_invalid_utf<tc::return_element_index>(tc::as_c_str("a\xc3\xa4\xe0\x80\x80")), 3); // overlong
+	_ASSERT(tc::is_valid_utf16(tc::as_c_str(u"a\xd83d\xde00")));
+	_ASSERTEQUAL(tc::find_first_invalid_utf<tc::return_element_index>(tc::as_c_str(u"ab\xd83d")), 2);
+}
@@ -0,0 +1,371 @@
+// think-cell public library
+//
+// Copyright (C) 2016-2023 think-cell Software GmbH
+//
+// Distributed under the Boost Software License, Version 1.0.
+// See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt
+
+#pragma once
+
+#include "base/assert_defs.h"
+#include "base/noncopyable.h"
+#include "base/tc_move.h"
+#include "algorithm/break_or_continue.h"
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace tc {
+	namespace thread_pool_detail {
+		// Lock-free work-stealing deque of Chase and Lev, with the memory orderings of
+		// Lê, Pop, Cohen and Zappa Nardelli, "Correct and Efficient Work-Stealing for Weak Memory Models", PPoPP 2013.
+		// The owning thread pushes and pops at the bottom, other threads steal from the top.
+		template<typename T>
+		struct chase_lev_deque final : tc::nonmovable {
+			static_assert( std::is_pointer<T>::value, "elements are read racily by thieves, store pointers" );
+
+			chase_lev_deque() noexcept
+				: m_pbuffer(new buffer(c_nInitialCapacity))
+			{
+				m_vecpbuffer.emplace_back(m_pbuffer.load(std::memory_order_relaxed));
+			}
+
+			// Owner only.
+			void push(T const t) & noexcept {
+				auto const nBottom = m_nBottom.load(std::memory_order_relaxed);
+				auto const nTop = m_nTop.load(std::memory_order_acquire);
+				auto pbuffer = m_pbuffer.load(std::memory_order_relaxed);
+				if( pbuffer->capacity() - 1 < nBottom - nTop ) {
+					pbuffer = grow(pbuffer, nTop, nBottom);
+				}
+				pbuffer->store(nBottom, t);
+				std::atomic_thread_fence(std::memory_order_release);
+				m_nBottom.store(nBottom + 1, std::memory_order_relaxed);
+			}
+
+			// Owner only. Returns the most recently pushed element, or nullptr if the deque is empty.
+			T pop() & noexcept {
+				auto const nBottom = m_nBottom.load(std::memory_order_relaxed) - 1;
+				auto const pbuffer = m_pbuffer.load(std::memory_order_relaxed);
+				m_nBottom.store(nBottom, std::memory_order_relaxed);
+				std::atomic_thread_fence(std::memory_order_seq_cst);
+				auto nTop = m_nTop.load(std::memory_order_relaxed);
+				T t = nullptr;
+				if( nTop <= nBottom ) {
+					t = pbuffer->load(nBottom);
+					if( nTop == nBottom ) {
+						// Last element, race against thieves for it.
+						if( !m_nTop.compare_exchange_strong(nTop, nTop + 1, std::memory_order_seq_cst, std::memory_order_relaxed) ) {
+							t = nullptr;
+						}
+						m_nBottom.store(nBottom + 1, std::memory_order_relaxed);
+					}
+				} else {
+					m_nBottom.store(nBottom + 1, std::memory_order_relaxed);
+				}
+				return t;
+			}
+
+			// Any thread. Returns the least recently pushed element, or nullptr if the deque is empty or another thread was faster.
+			T steal() & noexcept {
+				auto nTop = m_nTop.load(std::memory_order_acquire);
+				std::atomic_thread_fence(std::memory_order_seq_cst);
+				auto const nBottom = m_nBottom.load(std::memory_order_acquire);
+				if( nTop < nBottom ) {
+					T const t = m_pbuffer.load(std::memory_order_acquire)->load(nTop);
+					if( m_nTop.compare_exchange_strong(nTop, nTop + 1, std::memory_order_seq_cst, std::memory_order_relaxed) ) {
+						return t;
+					}
+				}
+				return nullptr;
+			}
+
+		private:
+			static constexpr std::ptrdiff_t c_nInitialCapacity = 64;
+
+			struct buffer final : tc::nonmovable {
+				explicit buffer(std::ptrdiff_t const nCapacity) noexcept
+					: m_nMask(nCapacity - 1)
+					, m_at(std::make_unique<std::atomic<T>[]>(tc::explicit_cast<std::size_t>(nCapacity)))
+				{
+					_ASSERTE( 0 == (nCapacity & m_nMask) );
+				}
+
+				std::ptrdiff_t capacity() const& noexcept {
+					return m_nMask + 1;
+				}
+
+				T load(std::ptrdiff_t const i) const& noexcept {
+					return m_at[tc::explicit_cast<std::size_t>(i & m_nMask)].load(std::memory_order_relaxed);
+				}
+
+				void store(std::ptrdiff_t const i, T const t) & noexcept {
+					m_at[tc::explicit_cast<std::size_t>(i & m_nMask)].store(t, std::memory_order_relaxed);
+				}
+
+			private:
+				std::ptrdiff_t const m_nMask;
+				std::unique_ptr<std::atomic<T>[]> const m_at;
+			};
+
+			buffer* grow(buffer* const pbufferOld, std::ptrdiff_t const nTop, std::ptrdiff_t const nBottom) & noexcept {
+				// Thieves may still read from the old buffer, so it is only freed with the deque.
+				auto const pbuffer = m_vecpbuffer.emplace_back(std::make_unique<buffer>(pbufferOld->capacity() * 2)).get();
+				for( auto i = nTop; i < nBottom; ++i ) {
+					pbuffer->store(i, pbufferOld->load(i));
+				}
+				m_pbuffer.store(pbuffer, std::memory_order_release);
+				return pbuffer;
+			}
+
+			alignas(64) std::atomic<std::ptrdiff_t> m_nTop{0}; // separate cache lines for thieves and owner
+			alignas(64) std::atomic<std::ptrdiff_t> m_nBottom{0};
+			std::atomic<buffer*> m_pbuffer;
+			std::vector<std::unique_ptr<buffer>> m_vecpbuffer; // owner only
+		};
+	}
+
+	namespace no_adl {
+		// Fixed-size pool of worker threads. Every worker owns a lock-free deque of tasks: it pops its own tasks in LIFO order
+		// (good locality for recursively split work) and steals from the other deques in FIFO order when it runs dry.
+		// Tasks submitted by other threads go through a shared queue.
+		// A pool with 0 workers runs tasks only on threads that wait for them with try_run_one, e.g., in tc::task_group::wait,
+		// in the order they were submitted. This makes parallel code deterministic for testing and debugging.
+		// Tasks must not throw; callers that need to propagate exceptions capture them inside the task, see tc::task_group.
+		struct thread_pool final : tc::nonmovable {
+			using task = tc::move_only_function<void() noexcept>;
+
+			explicit thread_pool(std::size_t const nWorkers) noexcept
+				: m_nWorkers(nWorkers)
+				, m_adeque(std::make_unique<thread_pool_detail::chase_lev_deque<task*>[]>(nWorkers))
+			{
+				m_vecthread.reserve(m_nWorkers);
+				for( std::size_t i = 0; i < m_nWorkers; ++i ) {
+					m_vecthread.emplace_back([this, i]() noexcept { run_worker(i); });
+				}
+			}
+
+			~thread_pool() {
+				while( try_run_one() ) {} // without workers, nobody else runs the remaining tasks
+				{
+					std::scoped_lock lock(m_mtxSleep);
+					m_bStop = true;
+				}
+				m_cvSleep.notify_all();
+				for( auto& thread : m_vecthread ) {
+					thread.join();
+				}
+			}
+
+			std::size_t worker_count() const& noexcept {
+				return m_nWorkers;
+			}
+
+			// Called from a worker, the task goes to the worker's own deque, otherwise to the shared queue.
+			void submit(task fn) & noexcept {
+				auto ptask = std::make_unique<task>(tc_move(fn));
+				if( this==t_pthreadpool ) {
+					m_adeque[t_iWorker].push(ptask.release());
+				} else {
+					std::scoped_lock lock(m_mtxShared);
+					m_deqptaskShared.push_back(tc_move(ptask));
+				}
+				m_nQueued.fetch_add(1, std::memory_order_seq_cst);
+				if( 0 < m_nSleeping.load(std::memory_order_seq_cst) ) {
+					// Pairs with the increment of m_nSleeping in run_worker: either the worker sees m_nQueued, or we see it sleeping.
+					std::scoped_lock lock(m_mtxSleep);
+					m_cvSleep.notify_one();
+				}
+			}
+
+			// Runs one queued task on the calling thread, if there is any. Waiting threads use this to help instead of blocking.
+			bool try_run_one() & noexcept {
+				if( auto ptask = try_pop() ) {
+					(*ptask)();
+					return true;
+				} else {
+					return false;
+				}
+			}
+
+		private:
+			std::unique_ptr<task> try_pop() & noexcept {
+				if( m_nQueued.load(std::memory_order_acquire) <= 0 ) return nullptr;
+				auto const bWorker = this==t_pthreadpool;
+				auto Popped = [&](task* const ptask) noexcept {
+					m_nQueued.fetch_sub(1, std::memory_order_relaxed);
+					return std::unique_ptr<task>(ptask);
+				};
+				if( bWorker ) {
+					if( auto const ptask = m_adeque[t_iWorker].pop() ) return Popped(ptask);
+				}
+				{
+					std::scoped_lock lock(m_mtxShared);
+					if( !m_deqptaskShared.empty() ) {
+						auto ptask = tc_move_always(m_deqptaskShared.front());
+						m_deqptaskShared.pop_front();
+						return Popped(ptask.release());
+					}
+				}
+				auto const iFirstVictim = bWorker ? t_iWorker + 1 : 0;
+				for( std::size_t n = 0; n < m_nWorkers; ++n ) {
+					if( auto const ptask = m_adeque[(iFirstVictim + n) % m_nWorkers].steal() ) return Popped(ptask);
+				}
+				return nullptr;
+			}
+
+			void run_worker(std::size_t const iWorker) & noexcept {
+				t_pthreadpool = this;
+				t_iWorker = iWorker;
+				for(;;) {
+					if( auto ptask = try_pop() ) {
+						(*ptask)();
+					} else {
+						std::unique_lock lock(m_mtxSleep);
+						m_nSleeping.fetch_add(1, std::memory_order_seq_cst);
+						m_cvSleep.wait(lock, [&]() noexcept { return m_bStop || 0 < m_nQueued.load(std::memory_order_seq_cst); });
+						m_nSleeping.fetch_sub(1, std::memory_order_relaxed);
+						if( m_bStop && m_nQueued.load(std::memory_order_acquire) <= 0 ) return;
+					}
+				}
+			}
+
+			static inline thread_local thread_pool* t_pthreadpool = nullptr;
+			static inline thread_local std::size_t t_iWorker = 0;
+
+			std::size_t const m_nWorkers;
+			std::unique_ptr<thread_pool_detail::chase_lev_deque<task*>[]> const m_adeque;
+			std::mutex m_mtxShared;
+			std::deque<std::unique_ptr<task>> m_deqptaskShared;
+			std::atomic<std::ptrdiff_t> m_nQueued{0}; // may be negative for a moment, if a task is taken before it is counted
+			std::atomic<std::size_t> m_nSleeping{0};
+			std::mutex m_mtxSleep;
+			std::condition_variable m_cvSleep;
+			bool m_bStop = false;
+			std::vector<std::thread> m_vecthread;
+		};
+	}
+	using no_adl::thread_pool;
+
+	namespace thread_pool_detail {
+		inline constexpr std::size_t c_nHardwareConcurrency = std::numeric_limits<std::size_t>::max();
+		inline std::atomic<std::size_t> g_nDefaultWorkers{c_nHardwareConcurrency};
+		inline std::atomic<bool> g_bDefaultCreated{false};
+	}
+
+	// Sets the number of workers of tc::default_thread_pool(), which defaults to one per hardware thread.
+	// Must be called before its first use, e.g., at the start of main. 0 makes all parallel algorithms run deterministically on the calling thread.
+	inline void set_default_thread_pool_worker_count(std::size_t const nWorkers) noexcept {
+		_ASSERT( !thread_pool_detail::g_bDefaultCreated.load(std::memory_order_relaxed) );
+		thread_pool_detail::g_nDefaultWorkers.store(nWorkers, std::memory_order_relaxed);
+	}
+
+	// Process-wide pool, created on first use.
+	inline tc::thread_pool& default_thread_pool() noexcept {
+		static tc::thread_pool s_threadpool([]() noexcept -> std::size_t {
+			thread_pool_detail::g_bDefaultCreated.store(true, std::memory_order_relaxed);
+			auto const nWorkers = thread_pool_detail::g_nDefaultWorkers.load(std::memory_order_relaxed);
+			return thread_pool_detail::c_nHardwareConcurrency == nWorkers ? std::max(std::thread::hardware_concurrency(), 1u) : nWorkers;
+		}());
+		return s_threadpool;
+	}
+
+	namespace no_adl {
+		// Scope for fork/join parallelism: run() forks tasks, wait() joins them.
+		// While waiting, the thread runs queued tasks instead of blocking. The destructor waits, too, so tasks may refer to local variables.
+		// The first exception thrown by a task is rethrown by wait(). Later exceptions, or any if wait() is not called, are dropped.
+		struct [[nodiscard]] task_group final : tc::nonmovable {
+			explicit task_group(tc::thread_pool& threadpool = tc::default_thread_pool()) noexcept
+				: m_threadpool(threadpool)
+			{}
+
+			~task_group() {
+				join();
+			}
+
+			template<typename Func>
+			void run(Func&& func) & noexcept {
+				{
+					std::scoped_lock lock(m_mtx);
+					++m_nPending;
+				}
+				m_threadpool.submit([this, ofunc = std::optional<tc::decay_t<Func>>(std::forward<Func>(func))]() mutable noexcept {
+					std::exception_ptr pexception;
+					try {
+						(*ofunc)(); // MAYTHROW
+					} catch(...) {
+						pexception = std::current_exception();
+					}
+					ofunc.reset(); // before wait() may return, because func may refer to objects that are destroyed afterwards
+					std::scoped_lock lock(m_mtx);
+					if( pexception && !m_pexception ) m_pexception = tc_move(pexception);
+					_ASSERT( 0 < m_nPending );
+					if( 0 == --m_nPending ) m_cv.notify_all(); // under the lock, because the waiting thread may destroy *this right after
+				});
+			}
+
+			void wait() & MAYTHROW {
+				join();
+				if( m_pexception ) {
+					std::rethrow_exception(std::exchange(m_pexception, nullptr));
+				}
+			}
+
+		private:
+			void join() & noexcept {
+				for(;;) {
+					{
+						std::scoped_lock lock(m_mtx);
+						if( 0 == m_nPending ) return;
+					}
+					if( !m_threadpool.try_run_one() ) {
+						// All of our tasks are taken by other threads, which help out themselves if they must wait for nested work.
+						std::unique_lock lock(m_mtx);
+						m_cv.wait(lock, [&]() noexcept { return 0 == m_nPending; });
+						return;
+					}
+				}
+			}
+
+			tc::thread_pool& m_threadpool;
+			std::size_t m_nPending = 0; // guarded by m_mtx
+			std::exception_ptr m_pexception; // guarded by m_mtx
+			std::mutex m_mtx;
+			std::condition_variable m_cv;
+		};
+	}
+	using no_adl::task_group;
+
+	// Runs the functions in parallel on the thread pool and returns when all of them are done.
+	// The first function runs on the calling thread. If functions throw, one of the exceptions is rethrown.
+	template<typename Func0, typename... Func>
+	void parallel_invoke(tc::thread_pool& threadpool, Func0&& func0, Func&&... func) MAYTHROW {
+		tc::task_group taskgroup(threadpool);
+		(taskgroup.run(std::forward<Func>(func)), ...);
+		std::exception_ptr pexception;
+		try {
+			std::forward<Func0>(func0)(); // MAYTHROW
+		} catch(...) {
+			pexception = std::current_exception();
+		}
+		taskgroup.wait(); // MAYTHROW
+		if( pexception ) std::rethrow_exception(pexception);
+	}
+
+	template<typename Func0, typename... Func>
+	void parallel_invoke(Func0&& func0, Func&&... func) MAYTHROW {
+		tc::parallel_invoke(tc::default_thread_pool(), std::forward<Func0>(func0), std::forward<Func>(func)...);
+	}
+}
@@ -0,0 +1,136 @@
+// think-cell public library
+//
+// Copyright (C) 2016-2023 think-cell Software GmbH
+//
+// Distributed under the Boost Software License, Version 1.0.
+// See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt
+
+#include "base/assert_defs.h"
+#include "unittest.h"
+#include "thread_pool.h"
+#include "container/insert.h"
+#include "algorithm/quantifier.h"
+#include "algorithm/empty.h"
+
+namespace {
+	long long fibonacci(tc::thread_pool& threadpool, int const n) noexcept {
+		if( n < 15 ) {
+			return n < 2 ? n : fibonacci(threadpool, n - 1) + fibonacci(threadpool, n - 2);
+		}
+		long long nFib1 = 0;
+		long long nFib2 = 0;
+		tc::parallel_invoke(threadpool, [&]() noexcept { nFib1 = fibonacci(threadpool, n - 1); }, [&]() noexcept { nFib2 = fibonacci(threadpool, n - 2); });
+		return nFib1 + nFib2;
+	}
+}
+
+UNITTESTDEF(chase_lev_deque) {
+	tc::vector<int> vecn(10000);
+	{
+		tc::thread_pool_detail::chase_lev_deque<int*> deque;
+		_ASSERTEQUAL(deque.pop(), nullptr);
+		_ASSERTEQUAL(deque.steal(), nullptr);
+		for( int i = 0; i < 200; ++i ) deque.push(&tc::at(vecn, i)); // grows
+		_ASSERTEQUAL(deque.pop(), &tc::at(vecn, 199));
+		_ASSERTEQUAL(deque.steal(), &tc::at(vecn, 0));
+		_ASSERTEQUAL(deque.steal(), &tc::at(vecn, 1));
+		for( int i = 198; 2 <= i; --i ) _ASSERTEQUAL(deque.pop(), &tc::at(vecn, i));
+		_ASSERTEQUAL(deque.pop(), nullptr);
+	}
+	{
+		// every element is taken exactly once by either the owner or one of the thieves
+		tc::thread_pool_detail::chase_lev_deque<int*> deque;
+		std::atomic<bool> bDone{false};
+		tc::vector<std::thread> vecthread;
+		for( int iThief = 0; iThief < 3; ++iThief ) {
+			vecthread.emplace_back([&]() noexcept {
+				for(;;) {
+					auto const bDoneBefore = bDone.load();
+					if( auto const pn = deque.steal() ) {
+						++*pn;
+					} else if( bDoneBefore ) {
+						return;
+					}
+				}
+			});
+		}
+		for( int i = 0; i < tc::size(vecn); ++i ) {
+			deque.push(&tc::at(vecn, i));
+			if( 0 == i % 3 ) {
+				if( auto const pn = deque.pop() ) ++*pn;
+			}
+		}
+		while( auto const pn = deque.pop() ) ++*pn;
+		bDone = true;
+		for( auto& thread : vecthread ) thread.join();
+		_ASSERT(tc::all_of(vecn, [](int const n) noexcept { return 1 == n; }));
+	}
+}
+
+UNITTESTDEF(task_group) {
+	for( std::size_t nWorkers : {0, 1, 4} ) {
+		tc::thread_pool threadpool(nWorkers);
+		_ASSERTEQUAL(fibonacci(threadpool, 25), 75025);
+
+		std::atomic<int> nCount{0};
+		{
+			tc::task_group taskgroup(threadpool);
+			for( int i = 0; i < 1000; ++i ) {
+				taskgroup.run([&]() noexcept { ++nCount; });
+			}
+			taskgroup.wait();
+			_ASSERTEQUAL(nCount.load(), 1000);
+			taskgroup.run([&]() noexcept { ++nCount; }); // a task group can be reused after wait
+		} // and waits when it goes out of scope
+		_ASSERTEQUAL(nCount.load(), 1001);
+
+		{
+			// the callables are destroyed before wait returns
+			auto const pn = std::make_shared<int>(0);
+			tc::task_group taskgroup(threadpool);
+			for( int i = 0; i < 100; ++i ) {
+				taskgroup.run([pn]() noexcept {});
+			}
+			taskgroup.wait();
+			_ASSERTEQUAL(pn.use_count(), 1);
+		}
+
+		// exceptions are rethrown by wait
+		tc::task_group taskgroup(threadpool);
+		taskgroup.run([]() MAYTHROW { throw 1; });
+		taskgroup.run([&]() noexcept { ++nCount; });
+		bool bCaught = false;
+		try {
+			taskgroup.wait();
+		} catch(int) {
+			bCaught = true;
+		}
+		_ASSERT(bCaught);
+		_ASSERTEQUAL(nCount.load(), 1002);
+
+		bCaught = false;
+		try {
+			tc::parallel_invoke(threadpool, [&]() noexcept { ++nCount; }, []() MAYTHROW { throw 2; });
+		} catch(int const n) {
+			_ASSERTEQUAL(n, 2);
+			bCaught = true;
+		}
+		_ASSERT(bCaught);
+	}
+}
+
+UNITTESTDEF(thread_pool_without_workers) {
+	// tasks run on the waiting thread in the order they were submitted, including nested ones
+	tc::thread_pool threadpool(0);
+	tc::vector<int> vecn;
+	tc::task_group taskgroup(threadpool);
+	for( int i = 0; i < 3; ++i ) {
+		taskgroup.run([&, i]() noexcept {
+			tc::cont_emplace_back(vecn, i);
+			taskgroup.run([&, i]() noexcept { tc::cont_emplace_back(vecn, 10 + i); });
+		});
+	}
+	_ASSERT(tc::empty(vecn));
+	taskgroup.wait();
+	TEST_RANGE_EQUAL(vecn, (tc::vector<int>{0, 1, 2, 10, 11, 12}));
+}